@@ -0,0 +1,254 @@
+/**
+ * @file bounded_queue.h
+ * @brief Bounded lock-free multi-producer multi-consumer queue.
+ *
+ * Ring buffer where every slot carries a sequence number that tells producers and
+ * consumers whether the slot is free or filled for their current lap (D. Vyukov's bounded
+ * MPMC design). tryPush() and tryPop() never block. push() and pop() apply backpressure to
+ * faster stages: while the queue is full or empty they retry for a short bounded spin and
+ * then sleep on a condition variable until the other side or close() wakes them, so idle
+ * stages take no CPU from the busy ones. The mutex is only touched when a thread sleeps
+ * or has to wake one. close() lets consumers drain what is left and then stop.
+ *
+ * The queue also records the depth it sees on every push, so pipeline reports can show
+ * which stage is falling behind.
+ *
+ * @date
+ * October 19, 2026
+ */
+
+#ifndef SUDOKUPROJECT_BOUNDED_QUEUE_H
+#define SUDOKUPROJECT_BOUNDED_QUEUE_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+template <typename T>
+class BoundedQueue {
+public:
+    /**
+     * @brief Creates a queue holding at least `capacity` items (rounded up to a power of two).
+     */
+    explicit BoundedQueue(size_t capacity) {
+        size_t size = 2;
+        while (size < capacity) size <<= 1;
+        cells_.reset(new Cell[size]);
+        mask_ = size - 1;
+        for (size_t i = 0; i < size; i++) {
+            cells_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    BoundedQueue(const BoundedQueue&) = delete;
+    BoundedQueue& operator=(const BoundedQueue&) = delete;
+
+    /**
+     * @brief Adds an item if there is room.
+     * @return false if the queue is full.
+     */
+    bool tryPush(const T& value) {
+        if (!enqueue(value)) return false;
+        wake(waitingPoppers_, notEmpty_);
+        return true;
+    }
+
+    /**
+     * @brief Removes the oldest item if there is one.
+     * @return false if the queue is empty.
+     */
+    bool tryPop(T& value) {
+        if (!dequeue(value)) return false;
+        wake(waitingPushers_, notFull_);
+        return true;
+    }
+
+    /**
+     * @brief Adds an item, spinning briefly and then sleeping while the queue is full.
+     * @return false if the queue was closed before the item could be added.
+     */
+    bool push(const T& value) {
+        for (int spin = 0; ; spin++) {
+            if (tryPush(value)) return true;
+            if (closed_.load(std::memory_order_acquire)) return false;
+            if (spin < SPIN_LIMIT) {
+                std::this_thread::yield();
+                continue;
+            }
+            bool pushed;
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                waitingPushers_.fetch_add(1);
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                // Checked again after registering, so a pop in between cannot be missed
+                pushed = enqueue(value);
+                if (!pushed && !closed_.load(std::memory_order_acquire)) notFull_.wait(lock);
+                waitingPushers_.fetch_sub(1);
+            }
+            if (pushed) {
+                wake(waitingPoppers_, notEmpty_);
+                return true;
+            }
+        }
+    }
+
+    /**
+     * @brief Removes the oldest item, spinning briefly and then sleeping while the queue is empty.
+     * @return false once the queue is closed and fully drained.
+     */
+    bool pop(T& value) {
+        for (int spin = 0; ; spin++) {
+            bool closed = closed_.load(std::memory_order_acquire);
+            if (tryPop(value)) return true;
+            if (closed) return false;
+            if (spin < SPIN_LIMIT) {
+                std::this_thread::yield();
+                continue;
+            }
+            bool popped;
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                waitingPoppers_.fetch_add(1);
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                closed = closed_.load(std::memory_order_acquire);
+                popped = dequeue(value);
+                if (!popped && !closed) notEmpty_.wait(lock);
+                waitingPoppers_.fetch_sub(1);
+            }
+            if (popped) {
+                wake(waitingPushers_, notFull_);
+                return true;
+            }
+        }
+    }
+
+    /**
+     * @brief Marks the queue as finished: no more pushes, consumers drain and stop.
+     */
+    void close() {
+        closed_.store(true, std::memory_order_release);
+        std::lock_guard<std::mutex> lock(mutex_);
+        notFull_.notify_all();
+        notEmpty_.notify_all();
+    }
+
+    /**
+     * @brief Approximate number of items currently queued.
+     */
+    size_t size() const {
+        size_t tail = enqueuePos_.load(std::memory_order_relaxed);
+        size_t head = dequeuePos_.load(std::memory_order_relaxed);
+        return tail > head ? tail - head : 0;
+    }
+
+    size_t capacity() const {
+        return mask_ + 1;
+    }
+
+    /**
+     * @brief Largest depth seen right after a push.
+     */
+    size_t maxDepth() const {
+        return maxDepth_.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Average depth seen right after a push.
+     */
+    double averageDepth() const {
+        size_t pushes = pushes_.load(std::memory_order_relaxed);
+        return pushes == 0 ? 0.0 : (double) depthSum_.load(std::memory_order_relaxed) / pushes;
+    }
+
+private:
+    struct Cell {
+        std::atomic<size_t> sequence;
+        T value;
+    };
+
+    // Lock-free cores of tryPush() and tryPop(); they wake nobody, so push() and pop() can
+    // call them while holding mutex_
+    bool enqueue(const T& value) {
+        size_t pos = enqueuePos_.load(std::memory_order_relaxed);
+        for (;;) {
+            Cell& cell = cells_[pos & mask_];
+            size_t sequence = cell.sequence.load(std::memory_order_acquire);
+            long diff = (long) sequence - (long) pos;
+            if (diff == 0) {
+                if (enqueuePos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    cell.value = value;
+                    cell.sequence.store(pos + 1, std::memory_order_release);
+                    recordDepth(pos + 1);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false;
+            } else {
+                pos = enqueuePos_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    bool dequeue(T& value) {
+        size_t pos = dequeuePos_.load(std::memory_order_relaxed);
+        for (;;) {
+            Cell& cell = cells_[pos & mask_];
+            size_t sequence = cell.sequence.load(std::memory_order_acquire);
+            long diff = (long) sequence - (long) (pos + 1);
+            if (diff == 0) {
+                if (dequeuePos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    value = cell.value;
+                    cell.sequence.store(pos + mask_ + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false;
+            } else {
+                pos = dequeuePos_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    // Failed attempts push() and pop() retry before they sleep
+    static const int SPIN_LIMIT = 64;
+
+    /**
+     * Wakes the threads sleeping on `condition` if `waiting` says there are any. The fence
+     * pairs with the one in push() and pop(): either the sleeper sees this thread's push or
+     * pop when it checks again, or this thread sees the sleeper registered.
+     */
+    void wake(std::atomic<int>& waiting, std::condition_variable& condition) {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (waiting.load(std::memory_order_relaxed) == 0) return;
+        std::lock_guard<std::mutex> lock(mutex_);
+        condition.notify_all();
+    }
+
+    void recordDepth(size_t tail) {
+        size_t head = dequeuePos_.load(std::memory_order_relaxed);
+        size_t depth = tail > head ? tail - head : 0;
+        pushes_.fetch_add(1, std::memory_order_relaxed);
+        depthSum_.fetch_add(depth, std::memory_order_relaxed);
+        size_t seen = maxDepth_.load(std::memory_order_relaxed);
+        while (depth > seen && !maxDepth_.compare_exchange_weak(seen, depth, std::memory_order_relaxed)) {}
+    }
+
+    std::unique_ptr<Cell[]> cells_;
+    size_t mask_ = 0;
+    alignas(64) std::atomic<size_t> enqueuePos_ {0};
+    alignas(64) std::atomic<size_t> dequeuePos_ {0};
+    alignas(64) std::atomic<bool> closed_ {false};
+    std::atomic<int> waitingPushers_ {0};
+    std::atomic<int> waitingPoppers_ {0};
+    std::mutex mutex_;
+    std::condition_variable notFull_;
+    std::condition_variable notEmpty_;
+    std::atomic<size_t> pushes_ {0};
+    std::atomic<size_t> depthSum_ {0};
+    std::atomic<size_t> maxDepth_ {0};
+};
+
+#endif //SUDOKUPROJECT_BOUNDED_QUEUE_H
@@ -0,0 +1,101 @@
+/**
+ * @file difficulty.h
+ * @brief Difficulty rating based on measured solver effort.
+ *
+ * This header declares functions to:
+ * - Rate a puzzle by how much work a propagating solver needs to finish it.
+ * - Map that effort to a difficulty bucket (Easy, Medium, Hard, Expert).
+ * - Fill difficulty buckets with target counts using parallel rejection sampling.
+ *
+ * The number of empty boxes is a poor predictor of how hard a puzzle is. The rating here
+ * instead records which techniques were needed (naked singles, hidden singles, guessing)
+ * and how much guessing the search had to do. It uses bitmask candidate sets, so rating
+ * a puzzle costs about as much as solving it once.
+ *
+ * @date
+ * October 19, 2026
+ */
+
+#ifndef SUDOKUPROJECT_DIFFICULTY_H
+#define SUDOKUPROJECT_DIFFICULTY_H
+
+#include <string>
+#include <vector>
+
+/**
+ * @brief Difficulty buckets, from easiest to hardest.
+ *
+ * - EASY: solved by naked singles alone.
+ * - MEDIUM: needs hidden singles, but no guessing.
+ * - HARD: needs at most HARD_MAX_GUESSES guesses.
+ * - EXPERT: needs more guessing than that.
+ */
+enum Difficulty { EASY = 0, MEDIUM = 1, HARD = 2, EXPERT = 3 };
+
+const int NUM_DIFFICULTIES = 4;
+
+/**
+ * @brief Maximum number of guesses for a puzzle to still count as HARD.
+ */
+const int HARD_MAX_GUESSES = 3;
+
+/**
+ * @brief Work done by the rating solver on one puzzle.
+ */
+struct SolveEffort {
+    Difficulty difficulty = EASY; ///< Bucket derived from the counters below.
+    int nakedSingles = 0;         ///< Cells filled because only one digit fit.
+    int hiddenSingles = 0;        ///< Cells filled because a digit fit only there in a unit.
+    int guesses = 0;              ///< Branch points where more than one digit had to be tried.
+    int nodes = 0;                ///< Search nodes visited, including the root.
+    int maxDepth = 0;             ///< Deepest level of nested guesses.
+    bool solved = false;          ///< false if the puzzle has no solution.
+};
+
+/**
+ * @brief Rates a Sudoku puzzle by the effort needed to solve it.
+ *
+ * First applies naked singles only. If that completes the board the puzzle is EASY.
+ * Otherwise hidden singles are added, and if that completes the board it is MEDIUM.
+ * Otherwise a depth-first search runs the same propagation at every node and counts
+ * guesses and depth. Digits are tried in a fixed order, so the rating is deterministic.
+ *
+ * @param BOARD A pointer to the 2D Sudoku board (int**), left unchanged.
+ * @return The measured effort and resulting difficulty.
+ */
+SolveEffort rateBoard(int** BOARD);
+
+/**
+ * @brief Returns a printable name for a difficulty bucket ("easy", "medium", ...).
+ *
+ * @param difficulty The bucket to name.
+ * @return The lowercase name of the bucket.
+ */
+std::string difficultyName(const Difficulty& difficulty);
+
+/**
+ * @brief A generated puzzle together with its rating.
+ */
+struct RatedPuzzle {
+    int** board;
+    SolveEffort effort;
+};
+
+/**
+ * @brief Generates uniquely solvable puzzles until each difficulty bucket is full.
+ *
+ * Worker threads repeatedly generate a minimal puzzle, add back a random number of its
+ * solution's clues (so easier buckets also get candidates), rate it with rateBoard() and
+ * keep it only if its bucket still needs puzzles. Sampling stops when every bucket has
+ * reached its target, or after `max_attempts` candidates so that an unreachable target
+ * cannot loop forever.
+ *
+ * @param targets Number of puzzles wanted per bucket, indexed by Difficulty.
+ * @param num_threads Number of generator threads (0 uses the hardware concurrency).
+ * @param max_attempts Maximum number of candidates to rate (0 means no limit).
+ * @return The accepted puzzles, grouped by bucket. The caller owns the boards.
+ */
+std::vector<RatedPuzzle> generateRatedPuzzles(const std::vector<int>& targets, const int& num_threads = 0,
+                                              const long long& max_attempts = 0);
+
+#endif //SUDOKUPROJECT_DIFFICULTY_H
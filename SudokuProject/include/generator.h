@@ -8,6 +8,7 @@
  * -  and generate a complete Sudoku board.
  * - Randomly delete cells to create a solvable puzzle.
  * - Generate a complete Sudoku puzzle with a specific number of empty cells.
+ * - Stream puzzles lazily into a reused buffer (PuzzleStream).
  *
  * Detailed function descriptions and parameters are provided below.
  *
@@ -22,6 +23,13 @@
 #define GENERATOR_H
 
 #include <vector>
+#include <random>
+#include <string>
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
 
 /**
  * @brief creates a 9x9 sudoku board.
@@ -80,4 +88,225 @@ void deleteRandomItems(int** BOARD, const int& n);
  */
 int** generateBoard(const int& empty_boxes);
 
+/**
+ * @brief checks whether clearing some clues keeps a puzzle uniquely solvable.
+ *
+ * BOARD must be uniquely solvable with solution SOLUTION. After clearing `cells`, any
+ * solution that agrees with SOLUTION on those cells is SOLUTION itself, so the puzzle stays
+ * unique exactly when no solution puts a different digit in one of them. Each alternative
+ * digit is tried with countSolutions(), which is far cheaper than recounting from scratch.
+ *
+ * @param BOARD A pointer to the uniquely solvable 2D Sudoku board (left unchanged).
+ * @param SOLUTION A pointer to the solved board matching BOARD.
+ * @param cells Flat cell indices (r * 9 + c) of the clues to clear.
+ * @return true if the puzzle is still uniquely solvable without those clues.
+ */
+bool isRemovalUnique(int** BOARD, int** SOLUTION, const std::vector<int>& cells);
+
+/**
+ * @brief A candidate removal: one clue, or a clue and its rotationally symmetric partner.
+ */
+struct ClueRemoval {
+    int cells[2];
+    int count;
+};
+
+/**
+ * @brief Persistent threads that test candidate clue removals in parallel.
+ *
+ * The threads and their scratch boards are created once and reused for every batch and
+ * every puzzle, so a batch costs one wake-up instead of starting and joining threads.
+ * The calling thread tests candidates too, so a pool of one thread starts none.
+ */
+class RemovalCheckPool {
+public:
+    /**
+     * @brief Starts num_threads - 1 worker threads (the caller is the last one).
+     */
+    explicit RemovalCheckPool(const int& num_threads);
+    ~RemovalCheckPool();
+
+    RemovalCheckPool(const RemovalCheckPool&) = delete;
+    RemovalCheckPool& operator=(const RemovalCheckPool&) = delete;
+
+    /**
+     * @brief Number of threads testing candidates, including the caller.
+     */
+    int threads() const;
+
+    /**
+     * @brief Runs isRemovalUnique() for `count` candidates at the same time.
+     *
+     * BOARD and SOLUTION are only read. The result of `removals[i]` goes to `passed[i]`.
+     * Returns once every candidate is tested.
+     */
+    void check(int** BOARD, int** SOLUTION, const ClueRemoval* removals, const int& count, char* passed);
+
+private:
+    void work(int** TRIAL);
+    void checkClaimed(int** TRIAL);
+
+    std::vector<std::thread> workers_;
+    std::vector<int**> trials_;
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    std::condition_variable done_;
+    long long generation_ = 0;
+    int busy_ = 0;
+    bool stopping_ = false;
+
+    // The batch being checked, valid while busy_ > 0
+    int** board_ = nullptr;
+    int** solution_ = nullptr;
+    const ClueRemoval* removals_ = nullptr;
+    char* passed_ = nullptr;
+    int count_ = 0;
+    std::atomic<int> next_ {0};
+};
+
+/**
+ * @brief generates a minimal, uniquely solvable sudoku puzzle.
+ *
+ * Starts from a completely solved board and visits its clues in random order (or in
+ * 180-degree rotationally symmetric pairs). A clue is removed only if isRemovalUnique()
+ * says the puzzle stays uniquely solvable. A clue that cannot be removed never becomes
+ * removable later, since clearing more clues only adds solutions, so each clue is
+ * rejected at most once and the result is minimal: no remaining clue (or symmetric pair)
+ * can be removed.
+ *
+ * With num_threads > 1 the next num_threads candidates are tested at the same time by
+ * a RemovalCheckPool that the calling thread keeps across puzzles.
+ * The first candidate that passes is removed. Failed candidates are discarded for good,
+ * and passing candidates after it are tested again against the smaller puzzle, which
+ * gives the same result as testing one candidate at a time.
+ *
+ * @param symmetric Remove clues in rotationally symmetric pairs.
+ * @param num_threads Number of candidate removals to test in parallel.
+ * @return A minimal, uniquely solvable board
+ */
+int** generateMinimalBoard(const bool& symmetric = false, const int& num_threads = 1);
+
+/**
+ * @brief Generates a puzzle of any box size (9x9, 16x16, 25x25, ...).
+ *
+ * Starts from the standard pattern solution and shuffles digits, rows within bands,
+ * bands, columns within stacks and stacks, which keeps it a valid solution. Then clears
+ * `empty_cells` random cells. The puzzle is solvable but not necessarily unique.
+ *
+ * @param cells Receives size * size cells (size = box_size * box_size), row-major, 0 for empty.
+ * @param box_size Side length of a box.
+ * @param empty_cells Number of cells to clear.
+ * @param generator Random generator to draw from.
+ */
+void generateBoardOfSize(int* cells, const int& box_size, const int& empty_cells, std::mt19937& generator);
+
+/**
+ * @brief How PuzzleStream turns a solved board into a puzzle.
+ *
+ * - RANDOM_REMOVAL: clear `empty_boxes` random cells, like generateBoard().
+ * - MINIMAL: remove clues while the puzzle stays unique, like generateMinimalBoard().
+ * - SYMMETRIC_MINIMAL: same as MINIMAL, removing rotationally symmetric pairs.
+ */
+enum PuzzleMode { RANDOM_REMOVAL = 0, MINIMAL = 1, SYMMETRIC_MINIMAL = 2 };
+
+/**
+ * @brief Count that makes a PuzzleStream endless; any other count is an exact number of puzzles.
+ */
+const long long ENDLESS_PUZZLE_STREAM = -1;
+
+/**
+ * @brief Lazy, pull-based source of generated puzzles.
+ *
+ * Generates one puzzle each time next() is called, into a board owned by the stream.
+ * All buffers are allocated once in the constructor and reused, so pulling a puzzle
+ * allocates nothing. The stream is also a range, so consumers can write
+ * `for (int** board : PuzzleStream(45, 1000)) { ... }` and take exactly as many puzzles
+ * as they need.
+ *
+ * The board returned by board() (or by dereferencing an iterator) is overwritten by
+ * the next call to next(). Callers that need to keep a puzzle must copy it.
+ */
+class PuzzleStream {
+public:
+    /**
+     * @brief Creates a stream of puzzles.
+     *
+     * @param empty_boxes Cells to clear per puzzle (RANDOM_REMOVAL only).
+     * @param count Number of puzzles to produce (0 or less produces none), or
+     *              ENDLESS_PUZZLE_STREAM for a stream that never ends.
+     * @param seed Seed for the stream's random generator (0 picks a random seed).
+     *             A fixed seed gives the same sequence of puzzles on every run.
+     * @param mode How clues are removed from each solved board.
+     * @param num_threads Threads testing clue removals in the minimal modes. The puzzles
+     *                    are the same for every thread count.
+     */
+    explicit PuzzleStream(const int& empty_boxes, const long long& count, const unsigned& seed = 0,
+                          const PuzzleMode& mode = RANDOM_REMOVAL, const int& num_threads = 1);
+    ~PuzzleStream();
+
+    PuzzleStream(const PuzzleStream&) = delete;
+    PuzzleStream& operator=(const PuzzleStream&) = delete;
+
+    /**
+     * @brief Generates the next puzzle into the stream's board.
+     * @return false once `count` puzzles have been produced.
+     */
+    bool next();
+
+    /**
+     * @brief The current puzzle, valid until the next call to next().
+     */
+    int** board() const;
+
+    /**
+     * @brief Number of puzzles generated so far.
+     */
+    long long produced() const;
+
+    /**
+     * @brief Saves the number of puzzles produced and the random generator state as one line of text.
+     */
+    std::string saveState() const;
+
+    /**
+     * @brief Continues from a state returned by saveState().
+     *
+     * The puzzles produced afterwards are the same as those produced after the
+     * saveState() call, even in another process.
+     *
+     * @return false if the state cannot be parsed (the stream is then unchanged).
+     */
+    bool restoreState(const std::string& state);
+
+    /**
+     * @brief Input iterator over the stream; incrementing it generates the next puzzle.
+     */
+    class iterator {
+    public:
+        explicit iterator(PuzzleStream* stream) : stream_(stream) {}
+        int** operator*() const { return stream_->board(); }
+        iterator& operator++();
+        bool operator==(const iterator& other) const { return stream_ == other.stream_; }
+        bool operator!=(const iterator& other) const { return stream_ != other.stream_; }
+    private:
+        PuzzleStream* stream_;
+    };
+
+    /**
+     * @brief Generates the first puzzle and returns an iterator to it.
+     */
+    iterator begin();
+    iterator end();
+
+private:
+    int empty_boxes_;
+    long long count_;
+    PuzzleMode mode_;
+    long long produced_ = 0;
+    std::mt19937 generator_;
+    int** board_;
+    int** solution_;
+    std::unique_ptr<RemovalCheckPool> pool_;
+};
+
 #endif // GENERATOR_H
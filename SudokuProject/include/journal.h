@@ -0,0 +1,150 @@
+/**
+ * @file journal.h
+ * @brief Append-only progress journal for resuming long batch runs.
+ *
+ * A batch run (creating or solving puzzles) records its progress in a small text file:
+ * the indices of completed puzzles, the random generator state and the next output
+ * offset. After a crash or preemption, the same run started again reads the journal,
+ * skips the completed work and continues from the last checkpoint.
+ *
+ * Progress is buffered in memory and appended in batches of `batch_size` items, so
+ * the journal costs one short write per batch instead of one per puzzle. Work done
+ * after the last flushed batch is simply done again, which gives the same output
+ * because the random generator state is restored too.
+ *
+ * File format, one record per line:
+ * - `run <key>`: the parameters of the run; a journal of another run is discarded.
+ * - `state <offset> <state>`: output offset and generator state at a checkpoint.
+ * - `done <offset> <index>...`: completed indices and the output offset after them.
+ * - `file <offset> <path>`: a completed input without an index in its file name and the
+ *   output offset after it.
+ *
+ * @date
+ * October 19, 2026
+ */
+
+#ifndef SUDOKUPROJECT_JOURNAL_H
+#define SUDOKUPROJECT_JOURNAL_H
+
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Completed items buffered before the journal appends them to its file.
+ */
+const int JOURNAL_BATCH_SIZE = 256;
+
+/**
+ * @brief Records the progress of one batch run and restores it on restart.
+ *
+ * markDone() is thread safe, so solver workers can record completions directly.
+ */
+class ProgressJournal {
+public:
+    /**
+     * @brief Opens the journal for a run, resuming it if the file belongs to the same run.
+     *
+     * A journal written for a different `run_key` (other parameters, folders or shard) is
+     * replaced by a fresh one. A record cut short by a crash is dropped.
+     *
+     * @param filename Path of the journal file.
+     * @param run_key Text identifying the run's parameters (no newlines).
+     * @param batch_size Completed items buffered before they are appended to the file.
+     */
+    ProgressJournal(const std::string& filename, const std::string& run_key, const int& batch_size = JOURNAL_BATCH_SIZE);
+    ~ProgressJournal();
+
+    ProgressJournal(const ProgressJournal&) = delete;
+    ProgressJournal& operator=(const ProgressJournal&) = delete;
+
+    /**
+     * @brief true if progress of an earlier attempt of this run was loaded.
+     */
+    bool resumed() const;
+
+    /**
+     * @brief Number of completed items loaded from the journal.
+     */
+    long long completedOnStart() const;
+
+    /**
+     * @brief Output offset of the last checkpoint (0 for a fresh run).
+     */
+    long long outputOffset() const;
+
+    /**
+     * @brief Generator state of the last checkpoint (empty for a fresh run or a run without one).
+     */
+    const std::string& generatorState() const;
+
+    /**
+     * @brief true if the item with this index was completed by an earlier attempt.
+     */
+    bool isDone(const int& index) const;
+
+    /**
+     * @brief true if the input with this path (and no index) was completed by an earlier attempt.
+     */
+    bool isDone(const std::string& path) const;
+
+    /**
+     * @brief Records a completed item; a full batch is appended to the file.
+     *
+     * @param index The item's index.
+     * @param output_offset The run's output offset after this item.
+     */
+    void markDone(const int& index, const long long& output_offset = 0);
+
+    /**
+     * @brief Records a completed input that has no index in its file name.
+     *
+     * @param path The input's path.
+     * @param output_offset The run's output offset after this item; it is stored with the
+     *                      path, so a resumed run continues numbering where this item left off.
+     */
+    void markDone(const std::string& path, const long long& output_offset = 0);
+
+    /**
+     * @brief Appends a checkpoint of a sequential run: everything before `output_offset`
+     * is done and `generator_state` produces the items from there on.
+     */
+    void checkpoint(const long long& output_offset, const std::string& generator_state);
+
+    /**
+     * @brief Appends buffered completions to the file.
+     */
+    void flush();
+
+    /**
+     * @brief Marks the run as finished by deleting the journal file.
+     *
+     * The next run with the same parameters then starts from scratch.
+     */
+    void finish();
+
+private:
+    void load(const std::string& run_key);
+    void appendLocked(const std::string& record);
+    void flushLocked();
+
+    std::string filename_;
+    int batch_size_;
+    bool resumed_ = false;
+    long long completed_on_start_ = 0;
+    long long output_offset_ = 0;
+    std::string generator_state_;
+    std::unordered_set<int> done_indices_;
+    std::unordered_set<std::string> done_paths_;
+
+    std::mutex mutex_;
+    std::ofstream file_;
+    std::vector<int> pending_indices_;
+    std::vector<std::pair<std::string, long long>> pending_paths_;
+    long long pending_offset_ = 0;
+};
+
+#endif //SUDOKUPROJECT_JOURNAL_H
@@ -0,0 +1,225 @@
+/**
+ * @file metrics.h
+ * @brief Low-overhead throughput and latency metrics for batch runs.
+ *
+ * This header declares:
+ * - LatencyHistogram: an HDR-style log-linear histogram of nanosecond latencies.
+ * - MetricSeries: a named counter + failure counter + latency histogram (one per stage
+ *   or per solver).
+ * - Metrics: a set of series for one run, with a text summary and a JSON report.
+ * - StatusReporter: a background thread printing a rate-limited status line.
+ *
+ * Recording a sample costs a few relaxed atomic increments and nothing else: no locks,
+ * no allocation and no console output. All formatting happens on the reporter thread or
+ * after the run, so the measured code is not slowed down.
+ *
+ * @date
+ * October 19, 2026
+ */
+
+#ifndef SUDOKUPROJECT_METRICS_H
+#define SUDOKUPROJECT_METRICS_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "perf_counters.h"
+
+/**
+ * @brief Log-linear latency histogram with about 3% relative precision.
+ *
+ * Values below 64 ns get one bucket each. Above that, every power-of-two range is split
+ * into 32 equal sub-buckets, similar to HdrHistogram. Buckets are atomic counters, so
+ * any number of threads can record at the same time.
+ */
+class LatencyHistogram {
+public:
+    static const int SUB_BUCKET_BITS = 5;
+    static const int SUB_BUCKETS = 1 << SUB_BUCKET_BITS;
+    static const int BUCKETS = (64 - SUB_BUCKET_BITS + 1) * SUB_BUCKETS;
+
+    LatencyHistogram();
+
+    /**
+     * @brief Adds one sample.
+     * @param nanoseconds The measured latency (negative values count as 0).
+     */
+    void record(long long nanoseconds);
+
+    long long count() const;
+    long long max() const;
+    double mean() const;
+
+    /**
+     * @brief Returns the latency at the given quantile (0.5 = median, 0.999 = p999).
+     *
+     * The result is the midpoint of the bucket holding that quantile, so it is
+     * within about 3% of the exact value.
+     */
+    long long percentile(const double& quantile) const;
+
+    /**
+     * @brief Sum of all recorded samples.
+     */
+    long long sum() const;
+
+    /**
+     * @brief The non-empty buckets as (bucket index, sample count) pairs.
+     */
+    std::vector<std::pair<int, long long>> buckets() const;
+
+    /**
+     * @brief Adds samples recorded by another histogram, e.g. one read back from a report.
+     *
+     * @param buckets (bucket index, sample count) pairs as returned by buckets().
+     * @param sum Sum of the added samples.
+     * @param max Largest added sample.
+     */
+    void addSamples(const std::vector<std::pair<int, long long>>& buckets, const long long& sum, const long long& max);
+
+private:
+    static int bucketIndex(unsigned long long value);
+    static unsigned long long bucketLow(const int& index);
+
+    std::unique_ptr<std::atomic<long long>[]> buckets_;
+    std::atomic<long long> count_ {0};
+    std::atomic<long long> sum_ {0};
+    std::atomic<long long> max_ {0};
+};
+
+/**
+ * @brief Counters and latency histogram for one stage or solver.
+ */
+struct MetricSeries {
+    std::string name;
+    std::atomic<long long> count {0};
+    std::atomic<long long> failures {0};
+    LatencyHistogram latency;
+    std::atomic<long long> perfTotals[NUM_PERF_EVENTS] {};   ///< Summed hardware counts per PerfEvent.
+    std::atomic<long long> perfSamples[NUM_PERF_EVENTS] {};  ///< Items that counted each PerfEvent.
+
+    /**
+     * @brief Records one finished item and how long it took.
+     * @param nanoseconds Time spent on the item.
+     * @param ok false counts the item as a failure.
+     */
+    void record(long long nanoseconds, const bool& ok = true);
+
+    /**
+     * @brief Adds the hardware counts of one item (see PerfCounters); unmeasured counters are skipped.
+     */
+    void recordPerf(const PerfSample& sample);
+
+    /**
+     * @brief Mean count of `event` per measured item, or -1 if it was never measured.
+     */
+    double perfMean(const PerfEvent& event) const;
+};
+
+/**
+ * @brief Nanoseconds elapsed since `start`, for use with MetricSeries::record().
+ */
+inline long long nanosecondsSince(const std::chrono::steady_clock::time_point& start) {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+}
+
+/**
+ * @brief The metric series of one batch run.
+ *
+ * Register every series with series() before the timed loop and keep the returned
+ * reference; recording through it is lock free.
+ */
+class Metrics {
+public:
+    explicit Metrics(const std::string& run_name);
+
+    /**
+     * @brief Returns the series with this name, creating it on first use.
+     *
+     * The reference stays valid for the lifetime of the Metrics object.
+     */
+    MetricSeries& series(const std::string& name);
+
+    /**
+     * @brief Seconds since the Metrics object was created.
+     */
+    double elapsedSeconds() const;
+
+    /**
+     * @brief Snapshot of all series as a JSON document.
+     *
+     * Contains the run name, elapsed time and, per series, the item count, failures,
+     * items per second and mean/p50/p99/p999/max latency in nanoseconds. The raw latency
+     * buckets are included too, so reports of separate runs can be merged with mergeJson().
+     * Series with hardware counts get a `perf` object mapping each counter to
+     * `[total, measured items]`.
+     */
+    std::string toJson() const;
+
+    /**
+     * @brief Writes toJson() to a file.
+     * @return true if writing was successful, false otherwise.
+     */
+    bool writeJson(const std::string& filename) const;
+
+    /**
+     * @brief Adds the series of a report written by writeJson() to this run.
+     *
+     * Counts, failures, latency buckets and hardware counts are summed per series name, so percentiles of
+     * the merged run are as precise as those of a single run. The elapsed time becomes the
+     * longest elapsed time of the merged reports, since shards run side by side.
+     *
+     * @return true if the report was read, false if it could not be opened or parsed.
+     */
+    bool mergeJson(const std::string& filename);
+
+    /**
+     * @brief Prints a table with throughput and latency percentiles for every series.
+     */
+    void printSummary() const;
+
+private:
+    std::string name_;
+    std::chrono::steady_clock::time_point start_;
+    double mergedElapsed_ = 0.0;
+    mutable std::mutex mutex_;
+    std::vector<std::unique_ptr<MetricSeries>> series_;
+};
+
+/**
+ * @brief Prints a single, periodically refreshed status line on a background thread.
+ *
+ * The line shows progress of one series against an expected total, its rate and
+ * its current p99 latency. It is refreshed at most once per `interval_ms`, so console
+ * output costs the same whether the run takes seconds or hours.
+ */
+class StatusReporter {
+public:
+    StatusReporter(const Metrics& metrics, MetricSeries& progress, const long long& total, const int& interval_ms = 500);
+    ~StatusReporter();
+
+    /**
+     * @brief Prints the final status line and stops the reporter thread.
+     */
+    void stop();
+
+private:
+    void printStatus() const;
+
+    const Metrics& metrics_;
+    MetricSeries& progress_;
+    long long total_;
+    std::chrono::milliseconds interval_;
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    bool stopped_ = false;
+    std::thread thread_;
+};
+
+#endif //SUDOKUPROJECT_METRICS_H
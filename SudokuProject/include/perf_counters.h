@@ -0,0 +1,97 @@
+/**
+ * @file perf_counters.h
+ * @brief Hardware performance counters around individual solver calls.
+ *
+ * Wall-clock time does not tell whether a solver is limited by branch mispredictions,
+ * cache misses or plain instruction count. PerfCounters reads the CPU's counters for
+ * cycles, instructions, branch misses and L1 data / last-level cache misses through
+ * Linux perf_event_open, in user space only and for the calling thread only.
+ *
+ * All counters form one perf event group, so starting, stopping and reading them costs
+ * one system call each, regardless of how many counters are open. Counters the CPU or
+ * the kernel does not offer are left out. Where none are available (other platforms,
+ * virtual machines without a PMU, or `kernel.perf_event_paranoid` forbidding it), every
+ * call is a no-op.
+ *
+ * @date
+ * October 19, 2026
+ */
+
+#ifndef SUDOKUPROJECT_PERF_COUNTERS_H
+#define SUDOKUPROJECT_PERF_COUNTERS_H
+
+#include <string>
+
+/**
+ * @brief The counters PerfCounters tries to open.
+ */
+enum PerfEvent { PERF_CYCLES = 0, PERF_INSTRUCTIONS = 1, PERF_BRANCH_MISSES = 2, PERF_L1D_MISSES = 3, PERF_LLC_MISSES = 4 };
+
+const int NUM_PERF_EVENTS = 5;
+
+/**
+ * @brief Returns the report name of a counter ("cycles", "instructions", ...).
+ */
+const char* perfEventName(const PerfEvent& event);
+
+/**
+ * @brief Counter values of one measured region.
+ */
+struct PerfSample {
+    long long values[NUM_PERF_EVENTS] = {0};
+    int measured = 0;   ///< Bit `1 << event` is set for every counter that was counted.
+
+    bool has(const PerfEvent& event) const { return (measured >> event) & 1; }
+};
+
+/**
+ * @brief A group of hardware counters for the calling thread.
+ *
+ * Create it on the thread that runs the measured code, then wrap each region in
+ * start() and stop(). Not thread safe.
+ */
+class PerfCounters {
+public:
+    /**
+     * @brief Opens every available counter; see available() and unavailableReason().
+     */
+    PerfCounters();
+    ~PerfCounters();
+
+    PerfCounters(const PerfCounters&) = delete;
+    PerfCounters& operator=(const PerfCounters&) = delete;
+
+    /**
+     * @brief true if at least one counter is open.
+     */
+    bool available() const;
+
+    /**
+     * @brief Why no counter could be opened (empty if available()).
+     */
+    const std::string& unavailableReason() const;
+
+    /**
+     * @brief Resets and starts all counters.
+     */
+    void start();
+
+    /**
+     * @brief Stops all counters and reads them.
+     *
+     * Counts are scaled up if the kernel had to multiplex the counters with other users.
+     *
+     * @param sample Receives the counts; `measured` is 0 if nothing was counted.
+     * @return true if at least one counter was read.
+     */
+    bool stop(PerfSample& sample);
+
+private:
+    int leader_ = -1;
+    int fds_[NUM_PERF_EVENTS];
+    int order_[NUM_PERF_EVENTS];   ///< Events in the order the group reports them.
+    int open_count_ = 0;
+    std::string reason_;
+};
+
+#endif //SUDOKUPROJECT_PERF_COUNTERS_H
@@ -0,0 +1,89 @@
+/**
+ * @file pipeline.h
+ * @brief In-memory generate -> solve -> validate -> persist pipeline.
+ *
+ * The default flow writes every generated puzzle to disk and parses it back before
+ * solving it. The pipeline keeps boards in memory instead: each stage runs on its own
+ * worker threads and hands boards to the next stage through a BoundedQueue. When a
+ * downstream stage falls behind, its input queue fills up and the upstream stage waits
+ * (backpressure), so memory use stays bounded.
+ *
+ * Every stage records how many items it processed, how long its workers were busy and
+ * how long they waited on their queues. Together with the queue depths, this shows which
+ * stage is the bottleneck.
+ *
+ * @date
+ * October 19, 2026
+ */
+
+#ifndef SUDOKUPROJECT_PIPELINE_H
+#define SUDOKUPROJECT_PIPELINE_H
+
+#include <string>
+#include <vector>
+
+/**
+ * @brief Settings for runPipeline().
+ */
+struct PipelineConfig {
+    int num_puzzles = 10;          ///< Number of puzzles to generate.
+    int empty_boxes = 45;          ///< Empty boxes per generated puzzle.
+    int generator_workers = 1;     ///< Threads in the generate stage.
+    int solver_workers = 1;        ///< Threads in the solve stage.
+    int validator_workers = 1;     ///< Threads in the validate stage.
+    int writer_workers = 1;        ///< Threads in the persist stage.
+    int queue_capacity = 256;      ///< Capacity of each queue between stages.
+    bool persist = false;          ///< Write puzzles and solutions to disk.
+    std::string puzzle_destination = "data/puzzles/";
+    std::string solution_destination = "data/solutions/";
+    std::string puzzle_prefix = "PUZZLE";
+    std::string solution_prefix = "SOLUTION";
+};
+
+/**
+ * @brief Counters collected for one pipeline stage.
+ */
+struct StageMetrics {
+    std::string name;
+    int workers = 0;
+    long long items = 0;          ///< Items the stage finished.
+    long long failures = 0;       ///< Unsolved, invalid or unwritten items.
+    double busy_seconds = 0.0;    ///< Time spent working, summed over workers.
+    double wait_seconds = 0.0;    ///< Time spent blocked on queues, summed over workers.
+    double queue_average_depth = 0.0; ///< Average depth of the stage's input queue.
+    size_t queue_max_depth = 0;       ///< Largest depth of the stage's input queue.
+    size_t queue_capacity = 0;        ///< Capacity of the stage's input queue (0 for the first stage).
+};
+
+/**
+ * @brief Result of a pipeline run.
+ */
+struct PipelineReport {
+    double wall_seconds = 0.0;
+    long long valid_solutions = 0;
+    std::vector<StageMetrics> stages;
+};
+
+/**
+ * @brief Runs the generate -> solve -> validate (-> persist) pipeline.
+ *
+ * Boards flow between stages through bounded lock-free queues. Each stage closes its
+ * output queue once its last worker finishes, so downstream stages drain and stop.
+ * Files are written only when `config.persist` is set.
+ *
+ * @param config Puzzle counts, worker counts, queue capacity and output paths.
+ * @return Wall time, number of valid solutions and per-stage metrics.
+ */
+PipelineReport runPipeline(const PipelineConfig& config);
+
+/**
+ * @brief Prints the per-stage throughput, utilization and queue depths of a run.
+ *
+ * The stage with the highest utilization (busy time per worker over wall time) is
+ * marked as the bottleneck.
+ *
+ * @param report The report returned by runPipeline().
+ */
+void printPipelineReport(const PipelineReport& report);
+
+#endif //SUDOKUPROJECT_PIPELINE_H
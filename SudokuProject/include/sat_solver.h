@@ -0,0 +1,215 @@
+/**
+ * @file sat_solver.h
+ * @brief Embedded CDCL SAT solver and a Sudoku encoding on top of it.
+ *
+ * This header declares:
+ * - SatSolver: a conflict-driven clause-learning SAT solver with two watched literals
+ *   per clause, first-UIP learning with non-chronological backjumping, VSIDS activity
+ *   branching with phase saving, and Luby restarts.
+ * - SudokuSat: a Sudoku board of any box size (9x9, 16x16, 25x25, ...) encoded as
+ *   clauses once and solved many times.
+ *
+ * Backtracking solvers forget why a branch failed and can hit the same dead end again in
+ * every sibling branch. The CDCL solver turns each conflict into a learned clause that
+ * prunes every later branch with the same cause, which pays off on hard and large boards.
+ *
+ * SudokuSat encodes only the rules of the board. The clues of a puzzle are passed as
+ * assumptions, so the rule clauses, their watch lists and the clauses learned from
+ * earlier puzzles (which follow from the rules alone) are kept and reused for the next
+ * puzzle instead of being rebuilt.
+ *
+ * @date
+ * October 19, 2026
+ */
+
+#ifndef SUDOKUPROJECT_SAT_SOLVER_H
+#define SUDOKUPROJECT_SAT_SOLVER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Counters of a SatSolver, accumulated over all solve() calls.
+ */
+struct SatStats {
+    long long decisions = 0;
+    long long propagations = 0;
+    long long conflicts = 0;
+    long long learned = 0;     ///< Clauses learned (including units).
+    long long restarts = 0;
+    long long purges = 0;      ///< Times long learned clauses were dropped to stay within the limit.
+};
+
+/**
+ * @brief CDCL SAT solver over clauses in a preallocated, reused literal arena.
+ *
+ * Variables are numbered from 0. A literal is `2 * var` for the positive and
+ * `2 * var + 1` for the negative form; use SatSolver::literal() to build one.
+ */
+class SatSolver {
+public:
+    enum Result { SAT = 0, UNSAT = 1, UNKNOWN = 2 };
+
+    SatSolver();
+
+    /**
+     * @brief Builds the literal of `var`, negated if `positive` is false.
+     */
+    static int literal(const int& var, const bool& positive = true) { return 2 * var + (positive ? 0 : 1); }
+
+    /**
+     * @brief Reserves space for variables, clauses and literals so building the formula does not reallocate.
+     */
+    void reserve(const int& vars, const long long& clauses, const long long& literals);
+
+    /**
+     * @brief Adds a variable and returns its number.
+     */
+    int newVar();
+
+    /**
+     * @brief Number of variables.
+     */
+    int numVars() const;
+
+    /**
+     * @brief Adds a clause (a disjunction of literals) to the formula.
+     *
+     * Must be called before the first solve() or between solve() calls.
+     *
+     * @return false if the formula became unsatisfiable.
+     */
+    bool addClause(const std::vector<int>& literals);
+
+    /**
+     * @brief Searches for an assignment satisfying all clauses and all `assumptions`.
+     *
+     * Assumptions hold only for this call; clauses learned under them are implied by the
+     * formula alone and are kept for later calls (up to the learned-clause limit).
+     *
+     * @param assumptions Literals that must be true.
+     * @param conflict_limit Give up after this many conflicts (0 = no limit).
+     * @return SAT, UNSAT (under the assumptions) or UNKNOWN if the limit was reached.
+     */
+    Result solve(const std::vector<int>& assumptions = {}, const long long& conflict_limit = 0);
+
+    /**
+     * @brief Value of `var` in the model found by the last successful solve().
+     */
+    bool modelValue(const int& var) const;
+
+    /**
+     * @brief Learned clauses kept before all but the shortest (3 literals or fewer) are
+     * dropped, at the next restart or solve() call (default 20000).
+     */
+    void setLearnedLimit(const int& limit);
+
+    const SatStats& stats() const;
+
+private:
+    static constexpr int NO_REASON = -1;
+    static constexpr int8_t UNASSIGNED = 2;
+
+    struct Watcher {
+        int clause;   ///< Offset of the clause in the arena.
+        int blocker;  ///< A literal of the clause; if it is true the clause needs no visit.
+    };
+
+    int8_t valueOf(const int& lit) const;
+    int decisionLevel() const;
+    void assign(const int& lit, const int& reason);
+    void watchClause(const int& clause);
+    int propagate();
+    void analyze(int conflict, std::vector<int>& learnt, int& backjump_level);
+    bool isRedundant(const int& lit);
+    void cancelUntil(const int& level);
+    int pickBranchLiteral();
+    void purgeLearned();
+
+    void bumpVar(const int& var);
+    void heapInsert(const int& var);
+    int heapPop();
+    void heapUp(int position);
+    void heapDown(int position);
+
+    // Clause arena: each clause is [size, literal...]. Rule clauses come first; learned
+    // clauses are appended after base_arena_size_, and purgeLearned() keeps only short ones.
+    std::vector<int> arena_;
+    std::size_t base_arena_size_ = 0;
+    int learned_count_ = 0;
+    int learned_limit_ = 20000;
+    std::vector<std::vector<Watcher>> watches_;
+
+    std::vector<int8_t> assigns_;
+    std::vector<int8_t> phase_;
+    std::vector<int> level_;
+    std::vector<int> reason_;
+    std::vector<int> trail_;
+    std::vector<int> trail_limits_;
+    std::size_t queue_head_ = 0;
+    bool unsatisfiable_ = false;
+
+    std::vector<double> activity_;
+    double var_increment_ = 1.0;
+    std::vector<int> heap_;
+    std::vector<int> heap_position_;
+
+    std::vector<int8_t> seen_;
+    std::vector<int> analyze_stack_;
+    std::vector<int8_t> model_;
+    SatStats stats_;
+};
+
+/**
+ * @brief Sudoku rules of one board size as a reusable SAT formula.
+ *
+ * Boards are `size() x size()` with `size() = box_size * box_size`, stored row-major in
+ * a flat array with 0 for an empty cell and 1..size() for a digit. Variable
+ * `(r * size() + c) * size() + d` means "cell (r, c) holds digit d + 1". The encoding has
+ * exactly-one clauses for every cell and for every digit in every row, column and box,
+ * so unit propagation performs both naked and hidden singles.
+ */
+class SudokuSat {
+public:
+    /**
+     * @brief Encodes the rules for boxes of `box_size x box_size` cells (3 for 9x9).
+     */
+    explicit SudokuSat(const int& box_size = 3);
+
+    /**
+     * @brief Side length of the board (box_size squared).
+     */
+    int size() const;
+
+    /**
+     * @brief Solves a board in place.
+     *
+     * @param cells size() * size() cells, row-major, 0 for empty. Filled in on success.
+     * @param conflict_limit Give up after this many conflicts (0 = no limit).
+     * @return true if the board was solved, false if it has no solution, its clues are
+     *         invalid or the limit was reached (`cells` is then unchanged).
+     */
+    bool solve(int* cells, const long long& conflict_limit = 0);
+
+    /**
+     * @brief Solves a dynamically allocated board (int**, size() rows) in place.
+     */
+    bool solve(int** BOARD, const long long& conflict_limit = 0);
+
+    /**
+     * @brief Counters of the underlying SatSolver, over all boards solved so far.
+     */
+    const SatStats& stats() const;
+
+private:
+    int variable(const int& r, const int& c, const int& digit) const;
+
+    int box_size_;
+    int size_;
+    SatSolver solver_;
+    std::vector<int> assumptions_;
+    std::vector<int> cells_;
+};
+
+#endif //SUDOKUPROJECT_SAT_SOLVER_H
@@ -0,0 +1,184 @@
+/**
+ * @file session.h
+ * @brief Stateful Sudoku session for interactive clients.
+ *
+ * This header declares SudokuSession, which holds one board being edited together with
+ * its candidate state. It answers, per keystroke:
+ * - Is this move legal?
+ * - Does the board still have a solution?
+ * - What is the next forced cell?
+ *
+ * The used digits of every row, column and box are kept as bitmasks and updated on each
+ * set() or clear(), so a legality check is a few bit operations. A solution found by
+ * isSolvable() is cached and stays valid until an edit contradicts it, so most
+ * solvability queries and hints do not search at all.
+ *
+ * Sessions are compact so that hundreds of thousands can stay live at once: digits are
+ * packed two per byte, the masks are 16 bits wide, and a session owns no heap memory
+ * (see SESSION_BYTES). Searches run on a scratch grid on the caller's stack with an undo
+ * trail instead of recursion and board copies, so their memory is not kept per session.
+ *
+ * @date
+ * October 19, 2026
+ */
+
+#ifndef SUDOKUPROJECT_SESSION_H
+#define SUDOKUPROJECT_SESSION_H
+
+#include <cstdint>
+
+/**
+ * @brief Bytes one SudokuSession occupies: 54 for the row, column and box masks, 41 each
+ * for the packed board and cached solution, 3 for the empty count and flags, and 1 of
+ * padding.
+ *
+ * A session holds no pointers, so N sessions in one array cost N * SESSION_BYTES.
+ */
+const int SESSION_BYTES = 140;
+
+/**
+ * @brief 81 digits (0-9) packed two per byte.
+ */
+struct PackedDigits {
+    std::uint8_t nibbles[41];
+
+    int get(const int& i) const { return (nibbles[i >> 1] >> ((i & 1) << 2)) & 0xF; }
+
+    void set(const int& i, const int& k) {
+        int shift = (i & 1) << 2;
+        nibbles[i >> 1] = (std::uint8_t) ((nibbles[i >> 1] & ~(0xF << shift)) | (k << shift));
+    }
+};
+
+/**
+ * @brief A cell and the digit that belongs there.
+ */
+struct CellMove {
+    int row = -1;
+    int col = -1;
+    int value = 0;
+};
+
+/**
+ * @brief One board being edited, with incremental candidates and a cached solution.
+ *
+ * Rows, columns and digits use the same conventions as the rest of the project:
+ * indices 0-8, digits 1-9 and 0 for an empty cell. Only legal moves are accepted,
+ * so the board never holds two equal digits in a row, column or box.
+ */
+class SudokuSession {
+public:
+    /**
+     * @brief Starts a session on a copy of BOARD.
+     *
+     * Conflicting clues are dropped (the later one in row-major order), so the session
+     * always starts from a consistent board.
+     *
+     * @param BOARD A pointer to the 9x9 Sudoku board to start from.
+     */
+    explicit SudokuSession(int** BOARD);
+
+    /**
+     * @brief Digit in a cell (0 if empty).
+     */
+    int get(const int& r, const int& c) const;
+
+    /**
+     * @brief Bitmask of the digits that can go into a cell (bit k-1 for digit k).
+     *
+     * Returns 0 for a filled cell.
+     */
+    int candidates(const int& r, const int& c) const;
+
+    /**
+     * @brief Checks whether `k` can be placed at `(r, c)` without breaking a rule.
+     *
+     * The cell must be empty and `k` must not appear in its row, column or box.
+     * This does not check that the board stays solvable; use wouldStaySolvable() for that.
+     */
+    bool isLegal(const int& r, const int& c, const int& k) const;
+
+    /**
+     * @brief Places `k` at `(r, c)` if the move is legal.
+     *
+     * Invalidates the cached solution only if it disagrees with the new digit.
+     *
+     * @return true if the digit was placed, false if the move was illegal.
+     */
+    bool set(const int& r, const int& c, const int& k);
+
+    /**
+     * @brief Empties a cell. The cached solution stays valid.
+     */
+    void clear(const int& r, const int& c);
+
+    /**
+     * @brief Number of empty cells.
+     */
+    int emptyCount() const;
+
+    /**
+     * @brief Checks whether the current board can still be completed.
+     *
+     * Answers from the cached solution when it agrees with every filled cell. Otherwise
+     * runs a bitmask search with minimum-remaining-values ordering and caches the result.
+     */
+    bool isSolvable();
+
+    /**
+     * @brief Checks whether the board would still be solvable after placing `k` at `(r, c)`.
+     *
+     * Does not change the board. Answers without a search when the cached solution
+     * already has `k` there.
+     */
+    bool wouldStaySolvable(const int& r, const int& c, const int& k);
+
+    /**
+     * @brief Finds a cell whose digit follows from the rules alone.
+     *
+     * Looks for a naked single (an empty cell with one candidate) first, then a hidden
+     * single (a digit with only one place left in a row, column or box).
+     *
+     * @param move Receives the cell and its digit.
+     * @return true if a forced cell exists.
+     */
+    bool nextForcedCell(CellMove& move) const;
+
+    /**
+     * @brief Suggests the next move: a forced cell if there is one, otherwise a digit
+     * from the solution for the empty cell with the fewest candidates.
+     *
+     * @param move Receives the cell and its digit.
+     * @return false if the board is complete or has no solution.
+     */
+    bool hint(CellMove& move);
+
+    /**
+     * @brief Copies a full solution of the current board into BOARD.
+     * @return false if the board has no solution (BOARD is then unchanged).
+     */
+    bool solution(int** BOARD);
+
+    /**
+     * @brief Copies the current board into BOARD.
+     */
+    void copyTo(int** BOARD) const;
+
+private:
+    int boxOf(const int& r, const int& c) const { return 3 * (r / 3) + c / 3; }
+    bool searchSolution(const int& cell = -1, const int& k = 0);
+
+    std::uint16_t rows_[9] = {0}, cols_[9] = {0}, boxes_[9] = {0};
+    PackedDigits cells_ = {};
+    std::uint8_t empty_ = 81;
+
+    // solution_ is a full solution of the current board whenever solutionValid_ is set.
+    // unsolvable_ records that the current board has none; only clear() can change that.
+    PackedDigits solution_ = {};
+    bool solutionValid_ = false;
+    bool unsolvable_ = false;
+};
+
+static_assert(sizeof(SudokuSession) == SESSION_BYTES, "SESSION_BYTES must match the session layout");
+
+#endif //SUDOKUPROJECT_SESSION_H
@@ -0,0 +1,334 @@
+/**
+ * @file solver_policies.h
+ * @brief Backtracking solver composed from compile-time policies.
+ *
+ * PolicySolver is a depth-first search over a 9x9 board whose three decisions are made
+ * by policy classes given as template arguments:
+ * - Cell selection: which empty cell to branch on (SequentialCell, MrvCell).
+ * - Value ordering: in which order to try its digits (AscendingValues, LeastConstrainingValues).
+ * - Propagation: what to fill in after every placement (NoPropagation, SinglesPropagation,
+ *   FullPropagation).
+ *
+ * Policies are structs with static member functions, so every combination is compiled
+ * into its own fully inlined search with no virtual calls or runtime switches. A new
+ * variant is one line, e.g. `PolicySolver<MrvCell, AscendingValues, FullPropagation>`.
+ *
+ * The board is kept as used-digit bitmasks per row, column and box, and every placement
+ * (including propagated ones) is pushed on a trail, so backtracking undoes exactly the
+ * cells placed since the branch point.
+ *
+ * @date
+ * October 19, 2026
+ */
+
+#ifndef SUDOKUPROJECT_SOLVER_POLICIES_H
+#define SUDOKUPROJECT_SOLVER_POLICIES_H
+
+#include <algorithm>
+
+/**
+ * @brief Outcome of a search: solved, proven unsolvable, or stopped by the node budget.
+ */
+enum SearchResult { SEARCH_SOLVED, SEARCH_EXHAUSTED, SEARCH_ABORTED };
+
+/**
+ * @brief Board state shared by the policies: cells, used-digit masks and an undo trail.
+ */
+struct PolicyBoard {
+    int cells[81];
+    int rows[9], cols[9], boxes[9];
+    int trail[81];            ///< Cells placed during the search, in order.
+    int trail_size = 0;
+    long long budget = -1;    ///< Nodes left (negative means unlimited).
+    long long nodes = 0;      ///< Branch points visited.
+
+    static int boxOf(const int& cell) { return 3 * (cell / 27) + (cell % 9) / 3; }
+
+    /**
+     * @brief i-th cell (0..8) of unit u: row u, column u - 9 or box u - 18.
+     */
+    static int unitCell(const int& u, const int& i) {
+        if (u < 9) return u * 9 + i;
+        if (u < 18) return i * 9 + (u - 9);
+        int b = u - 18;
+        return (3 * (b / 3) + i / 3) * 9 + 3 * (b % 3) + i % 3;
+    }
+
+    /**
+     * @brief Digits (bit k - 1 for digit k) that fit into `cell`.
+     */
+    int candidates(const int& cell) const {
+        return ~(rows[cell / 9] | cols[cell % 9] | boxes[boxOf(cell)]) & 0x1FF;
+    }
+
+    void place(const int& cell, const int& k) {
+        int bit = 1 << (k - 1);
+        cells[cell] = k;
+        rows[cell / 9] |= bit; cols[cell % 9] |= bit; boxes[boxOf(cell)] |= bit;
+        trail[trail_size++] = cell;
+    }
+
+    /**
+     * @brief Clears the cells placed after the trail had `mark` entries.
+     */
+    void undo(const int& mark) {
+        while (trail_size > mark) {
+            int cell = trail[--trail_size];
+            int bit = 1 << (cells[cell] - 1);
+            cells[cell] = 0;
+            rows[cell / 9] ^= bit; cols[cell % 9] ^= bit; boxes[boxOf(cell)] ^= bit;
+        }
+    }
+
+    /**
+     * @brief Copies the clues of BOARD.
+     * @return false if two clues clash in a row, column or box.
+     */
+    bool load(int** BOARD) {
+        trail_size = 0;
+        for (int u = 0; u < 9; u++) rows[u] = cols[u] = boxes[u] = 0;
+        bool consistent = true;
+        for (int i = 0; i < 81; i++) {
+            int k = BOARD[i / 9][i % 9];
+            cells[i] = k;
+            if (k < 1 || k > 9) continue;
+            int bit = 1 << (k - 1);
+            if ((rows[i / 9] | cols[i % 9] | boxes[boxOf(i)]) & bit) consistent = false;
+            rows[i / 9] |= bit; cols[i % 9] |= bit; boxes[boxOf(i)] |= bit;
+        }
+        return consistent;
+    }
+
+    void store(int** BOARD) const {
+        for (int i = 0; i < 81; i++) BOARD[i / 9][i % 9] = cells[i];
+    }
+};
+
+// ========================= Cell Selection ===============================
+
+/**
+ * @brief First empty cell in row-major order, starting after the last branch (solveBoard()).
+ */
+struct SequentialCell {
+    static int select(const PolicyBoard& board, const int& from, int& mask) {
+        for (int i = from; i < 81; i++) {
+            if (board.cells[i] != 0) continue;
+            mask = board.candidates(i);
+            return i;
+        }
+        return -1;
+    }
+};
+
+/**
+ * @brief Empty cell with the fewest candidates (solveBoardEfficient()).
+ *
+ * Ties go to the last such cell and a cell with one candidate is taken at once, the
+ * same choice findNextCell() makes.
+ */
+struct MrvCell {
+    static int select(const PolicyBoard& board, const int&, int& mask) {
+        int best = -1, bestCount = 10;
+        for (int i = 0; i < 81; i++) {
+            if (board.cells[i] != 0) continue;
+            int candidates = board.candidates(i);
+            int count = __builtin_popcount(candidates);
+            if (count == 1) {
+                mask = candidates;
+                return i;
+            }
+            if (count <= bestCount) {
+                best = i;
+                bestCount = count;
+                mask = candidates;
+            }
+        }
+        return best;
+    }
+};
+
+// ========================= Value Ordering ===============================
+
+/**
+ * @brief Digits from 1 to 9.
+ */
+struct AscendingValues {
+    static int order(const PolicyBoard&, const int&, int mask, int* digits) {
+        int count = 0;
+        while (mask != 0) {
+            digits[count++] = __builtin_ctz(mask) + 1;
+            mask &= mask - 1;
+        }
+        return count;
+    }
+};
+
+/**
+ * @brief Digits that remove the fewest candidates from the cell's empty peers first.
+ */
+struct LeastConstrainingValues {
+    static int order(const PolicyBoard& board, const int& cell, int mask, int* digits) {
+        int count = AscendingValues::order(board, cell, mask, digits);
+        if (count < 2) return count;
+        int r = cell / 9, c = cell % 9, b = PolicyBoard::boxOf(cell);
+        int cost[10] = {0};
+        for (int i = 0; i < 9; i++) {
+            int peers[3] = {r * 9 + i, i * 9 + c, PolicyBoard::unitCell(18 + b, i)};
+            for (int p = 0; p < 3; p++) {
+                int peer = peers[p];
+                // Box peers in the cell's row or column were already counted
+                if (peer == cell || board.cells[peer] != 0 || (p == 2 && (peer / 9 == r || peer % 9 == c))) continue;
+                int shared = board.candidates(peer) & mask;
+                while (shared != 0) {
+                    cost[__builtin_ctz(shared) + 1]++;
+                    shared &= shared - 1;
+                }
+            }
+        }
+        std::stable_sort(digits, digits + count, [&](int a, int b) { return cost[a] < cost[b]; });
+        return count;
+    }
+};
+
+// ========================= Propagation ==================================
+
+/**
+ * @brief Places nothing; the search alone fills the board.
+ */
+struct NoPropagation {
+    static bool propagate(PolicyBoard&) { return true; }
+};
+
+/**
+ * @brief Fills naked singles (cells with one candidate) until none are left.
+ */
+struct SinglesPropagation {
+    static bool propagate(PolicyBoard& board) {
+        bool changed = true;
+        while (changed) {
+            changed = false;
+            for (int i = 0; i < 81; i++) {
+                if (board.cells[i] != 0) continue;
+                int mask = board.candidates(i);
+                if (mask == 0) return false;
+                if ((mask & (mask - 1)) == 0) {
+                    board.place(i, __builtin_ctz(mask) + 1);
+                    changed = true;
+                }
+            }
+        }
+        return true;
+    }
+};
+
+/**
+ * @brief Fills naked singles and hidden singles (a digit with one place in a unit) until
+ * none are left, and fails as soon as a digit has no place left in some unit.
+ */
+struct FullPropagation {
+    static bool propagate(PolicyBoard& board) {
+        bool changed = true;
+        while (changed) {
+            if (!SinglesPropagation::propagate(board)) return false;
+            changed = false;
+            for (int u = 0; u < 27; u++) {
+                int placed = 0, seenOnce = 0, seenTwice = 0;
+                for (int i = 0; i < 9; i++) {
+                    int cell = PolicyBoard::unitCell(u, i);
+                    if (board.cells[cell] != 0) {
+                        placed |= 1 << (board.cells[cell] - 1);
+                        continue;
+                    }
+                    int mask = board.candidates(cell);
+                    seenTwice |= seenOnce & mask;
+                    seenOnce |= mask;
+                }
+                if ((placed | seenOnce) != 0x1FF) return false;
+                int unique = seenOnce & ~seenTwice;
+                for (int i = 0; i < 9 && unique != 0; i++) {
+                    int cell = PolicyBoard::unitCell(u, i);
+                    if (board.cells[cell] != 0) continue;
+                    int bit = board.candidates(cell) & unique;
+                    if (bit == 0) continue;
+                    bit &= -bit;
+                    board.place(cell, __builtin_ctz(bit) + 1);
+                    unique &= ~bit;
+                    changed = true;
+                }
+            }
+        }
+        return true;
+    }
+};
+
+// ========================= Solver =======================================
+
+/**
+ * @brief Depth-first search composed from a cell selection, a value ordering and a
+ * propagation policy.
+ */
+template <typename CellSelection, typename ValueOrdering, typename Propagation>
+class PolicySolver {
+public:
+    /**
+     * @brief Solves a board in place.
+     *
+     * @param BOARD A pointer to the dynamically allocated 9x9 Sudoku board.
+     * @param budget Branch points before giving up (negative means unlimited).
+     * @param nodes If not null, receives the number of branch points visited.
+     * @param from First cell considered by SequentialCell (r * 9 + c); earlier cells are left as they are.
+     * @return SEARCH_SOLVED with the board filled in; SEARCH_EXHAUSTED if there is no
+     *         solution, including when clues clash. The board is only changed when solved.
+     */
+    static SearchResult run(int** BOARD, const long long& budget = -1, long long* nodes = nullptr, const int& from = 0) {
+        PolicyBoard board;
+        bool consistent = board.load(BOARD);
+        board.budget = budget;
+        SearchResult result = consistent && Propagation::propagate(board) ? search(board, from) : SEARCH_EXHAUSTED;
+        if (nodes != nullptr) *nodes = board.nodes;
+        if (result == SEARCH_SOLVED) board.store(BOARD);
+        return result;
+    }
+
+    /**
+     * @brief Solves a board in place without a budget.
+     * @return true if the board is solved, false if it has no solution (board unchanged).
+     */
+    static bool solve(int** BOARD) {
+        return run(BOARD) == SEARCH_SOLVED;
+    }
+
+private:
+    static SearchResult search(PolicyBoard& board, const int& from) {
+        int mask = 0;
+        int cell = CellSelection::select(board, from, mask);
+        if (cell < 0) return SEARCH_SOLVED;
+        if (board.budget == 0) return SEARCH_ABORTED;
+        if (board.budget > 0) board.budget--;
+        board.nodes++;
+
+        int digits[9];
+        int count = ValueOrdering::order(board, cell, mask, digits);
+        for (int i = 0; i < count; i++) {
+            int mark = board.trail_size;
+            board.place(cell, digits[i]);
+            SearchResult result = Propagation::propagate(board) ? search(board, cell + 1) : SEARCH_EXHAUSTED;
+            if (result == SEARCH_SOLVED) return result;
+            board.undo(mark);
+            if (result == SEARCH_ABORTED) return result;
+        }
+        return SEARCH_EXHAUSTED;
+    }
+};
+
+/**
+ * @brief solveBoard(): row-major cells, digits 1 to 9, no propagation.
+ */
+using SequentialSolver = PolicySolver<SequentialCell, AscendingValues, NoPropagation>;
+
+/**
+ * @brief solveBoardEfficient(): fewest-candidates cell, digits 1 to 9, no propagation.
+ */
+using MrvSolver = PolicySolver<MrvCell, AscendingValues, NoPropagation>;
+
+#endif //SUDOKUPROJECT_SOLVER_POLICIES_H
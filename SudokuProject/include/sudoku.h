@@ -22,6 +22,8 @@
 #define SUDOKUPROJECT_SUDOKU_H
 
 #include <iostream>
+#include <functional>
+#include <tuple>
 
 /**
  * @brief Checks if a given number can be placed at a specific position on the Sudoku board.
@@ -44,6 +46,8 @@ bool isValid(int** BOARD, const int& r, const int& c, const int& k);
  * checking if the placement is valid. Proceeds cell by cell in a row-wise fashion.
  * Backtracks if no valid number can be placed in a cell.
  *
+ * This is the SequentialSolver instantiation of PolicySolver (see solver_policies.h).
+ *
  * @param BOARD Pointer to a dynamically allocated 9x9 Sudoku board.
  * @param r Row index to start solving from (default is 0).
  * @param c Column index to start solving from (default is 0).
@@ -68,29 +72,242 @@ std::tuple<int, int, int> findNextCell(int** BOARD);
 /**
  * @brief Solves the Sudoku board using recursive backtracking.
  *
- * Uses findNextCell() to select the next empty cell with the fewest valid options.
- * If no empty cells remain (r = -1, c = -1), the board is solved and returns true.
+ * Selects the empty cell with the fewest valid options (the cell findNextCell() would
+ * pick). If no empty cells remain, the board is solved and returns true.
  *
- * Iterates through numbers 1 to 9, checking validity with isValid(). If valid, places
- * the number and recursively calls solveBoardEfficient(). If the call returns true,
- * the board is solved. If false, backtracks by resetting the cell to 0.
+ * Iterates through the cell's valid numbers from 1 to 9, places each and recurses. If
+ * the recursion succeeds, the board is solved. If not, backtracks by resetting the cell to 0.
  *
  * Returns false if no valid number works.
  *
+ * This is the MrvSolver instantiation of PolicySolver (see solver_policies.h), which
+ * tracks the valid options as bitmasks.
+ *
  * @param BOARD A pointer to the dynamically allocated 9x9 Sudoku board.
  * @return true if the board is solved, false otherwise.
  */
 bool solveBoardEfficient(int** BOARD);
 
+// ===================== Value Ordering and Restarts ======================
+
+/**
+ * @brief Order in which solveBoardWithOptions() tries the digits of a cell.
+ *
+ * - ASCENDING: 1 to 9, like solveBoard() and solveBoardEfficient().
+ * - LEAST_CONSTRAINING: digits that remove the fewest candidates from the cell's empty
+ *   peers first.
+ * - RANDOM_ORDER: a fresh random order at every cell.
+ */
+enum ValueOrder { ASCENDING = 0, LEAST_CONSTRAINING = 1, RANDOM_ORDER = 2 };
+
+/**
+ * @brief How the search is restarted when an attempt runs out of nodes.
+ *
+ * - NO_RESTARTS: a single attempt (bounded only by node_limit).
+ * - LUBY_RESTARTS: attempt i gets restart_base * luby(i) nodes (1, 1, 2, 1, 1, 2, 4, ...).
+ * - GEOMETRIC_RESTARTS: attempt i gets restart_base * restart_factor^i nodes.
+ */
+enum RestartStrategy { NO_RESTARTS = 0, LUBY_RESTARTS = 1, GEOMETRIC_RESTARTS = 2 };
+
+/**
+ * @brief Settings for solveBoardWithOptions().
+ */
+struct SearchOptions {
+    ValueOrder order = ASCENDING;
+    RestartStrategy restarts = NO_RESTARTS;
+    long long restart_base = 100;    ///< Nodes in the first attempt.
+    double restart_factor = 1.5;     ///< Growth per attempt for GEOMETRIC_RESTARTS.
+    long long node_limit = 0;        ///< Nodes over all attempts before giving up (0 means no limit).
+    unsigned seed = 0;               ///< Seed for random orders and tie-breaks (0 picks a random seed).
+};
+
+/**
+ * @brief Solves the board with MRV cell selection, a chosen value order and restarts.
+ *
+ * Picks cells with findNextCell() like solveBoardEfficient(), but tries digits in the
+ * order given by `options.order`. Solve times of plain backtracking are heavy-tailed:
+ * an early wrong guess can cost orders of magnitude more than a typical run. With
+ * restarts, each attempt gets a node budget; when the budget runs out the board is reset
+ * and the search starts over with a new random order (ties are broken randomly for
+ * LEAST_CONSTRAINING; ASCENDING becomes RANDOM_ORDER), so one unlucky guess cannot
+ * dominate the run time. An attempt that finishes within its budget without a solution
+ * proves that there is none.
+ *
+ * @param BOARD A pointer to the dynamically allocated 9x9 Sudoku board.
+ * @param options Value order, restart strategy and node limits.
+ * @param nodes If not null, receives the number of search nodes visited.
+ * @return true if the board is solved, false if it has no solution (clashing clues
+ *         included) or node_limit was hit (the board is left unchanged in that case).
+ */
+bool solveBoardWithOptions(int** BOARD, const SearchOptions& options, long long* nodes = nullptr);
+
+// ========================= Adaptive Dispatch ============================
+
+/**
+ * @brief Solver engines that solve() can run.
+ *
+ * - BASIC_SOLVER: solveBoard(), row-by-row backtracking.
+ * - EFFICIENT_SOLVER: solveBoardEfficient(), MRV backtracking.
+ * - RESTART_SOLVER: solveBoardWithOptions() with random value order and Luby restarts,
+ *   using a fixed seed so the same board always gets the same solution.
+ * - ADAPTIVE_SOLVER: solveAdaptive(): naked singles, then the row-by-row search with a
+ *   node budget, escalating to the restart solver.
+ * - SAT_SOLVER: the CDCL SAT solver of sat_solver.h (one SudokuSat per thread, reused).
+ */
+enum SolverKind { BASIC_SOLVER = 0, EFFICIENT_SOLVER = 1, RESTART_SOLVER = 2, ADAPTIVE_SOLVER = 3, SAT_SOLVER = 4 };
+
+/**
+ * @brief Thresholds used by solveAdaptive(): which boards start with the row-by-row
+ * search, and its node budget.
+ *
+ * Empty cells are counted after solveAdaptive() has filled naked singles
+ * (DispatchDecision::empty), not in the input: a generated puzzle with 40 empty cells has
+ * about 7 left, one with 45 about 18 and one with 50 about 42.
+ *
+ * The defaults come from solveAdaptive() runs on generated puzzles with 40 to 64 empty
+ * cells and on minimal puzzles, after the row-by-row search moved to bitmask candidates
+ * (SequentialSolver): it now has the lower mean and p99 time at every empty count, for
+ * example 0.01 vs 0.14 ms at p50 for 50 empty cells in the input and 0.02 vs 0.26 ms at
+ * 64. So with the defaults the dispatch is sequential plus budget escalation: every board
+ * starts with the row-by-row search, and only the node budget sends a board to the
+ * restart solver. The budget cuts the tail: about 15% of boards with 60 or more empty
+ * cells escalate, a smaller budget escalates more of them without lowering p99, and
+ * 100000 nodes doubles p99 there. sequential_max_empty and sequential_max_density only
+ * send boards straight to the restart solver when they are lowered, for example by
+ * calibrateSolverDispatch() on a machine where the restart solver wins above some count.
+ */
+struct DispatchThresholds {
+    int sequential_max_empty = 81;          ///< Use row-by-row search up to this many empty cells after naked singles.
+    double sequential_max_density = 9.0;    ///< ... and at most this many candidates per empty cell (9 = any).
+    long long sequential_node_budget = 20000; ///< Nodes before escalating to the restart solver.
+};
+
+/**
+ * @brief Replaces the thresholds used by solveAdaptive().
+ *
+ * Not synchronized: call it before any thread starts solving.
+ */
+void setDispatchThresholds(const DispatchThresholds& thresholds);
+
+/**
+ * @brief Returns the thresholds currently used by solveAdaptive().
+ */
+DispatchThresholds getDispatchThresholds();
+
+/**
+ * @brief Features and engine recorded by solveAdaptive().
+ */
+struct DispatchDecision {
+    int empty = 0;                 ///< Empty cells left after propagation.
+    double density = 0.0;          ///< Average candidates per empty cell after propagation.
+    SolverKind engine = BASIC_SOLVER; ///< Engine that produced the answer.
+    bool propagated = false;       ///< true if naked singles alone solved the board.
+    bool escalated = false;        ///< true if the first engine ran out of budget.
+};
+
+/**
+ * @brief Solves the board with the row-by-row search, escalating to the restart solver.
+ *
+ * First fills naked singles with bitmask candidate sets, which also detects
+ * contradictions and measures the remaining empty cells and candidate density. Boards
+ * that are then complete need no search. The others go to the row-by-row search with
+ * DispatchThresholds::sequential_node_budget nodes; if the budget runs out they escalate
+ * to the restart solver, which is complete. Only boards above lowered
+ * DispatchThresholds limits skip the row-by-row search (none with the defaults).
+ *
+ * @param BOARD A pointer to the dynamically allocated 9x9 Sudoku board.
+ * @param decision If not null, receives the features and the engine used.
+ * @return true if the board is solved, false if it has no solution (BOARD is then unchanged).
+ */
+bool solveAdaptive(int** BOARD, DispatchDecision* decision = nullptr);
+
+/**
+  * @brief indicates which solver to use when solving sudoku board.
+  *
+  * Runs the engine named by `kind`, by default solveAdaptive().
+  *
+  * @param board pointer to the dynamically allocated 2D array.
+  * @param kind engine to run (ADAPTIVE_SOLVER if not provided).
+  * @return solved board.
+  */
+bool solve(int** board, const SolverKind& kind = ADAPTIVE_SOLVER);
+
 /**
   * @brief indicates which solver to use when solving sudoku board.
   *
   * Calls solveBoardEfficient() if efficient equals true. otherwise calls solveBoard().
   *
   * @param board pointer to the dynamically allocated 2D array.
-  * @param efficient boolean indicating which solver to use(false if not provided).
+  * @param efficient boolean indicating which solver to use.
   * @return solved board.
   */
-bool solve(int** board, const bool& efficient = false);
+bool solve(int** board, const bool& efficient);
+
+// ========================= Boards of Any Size ===========================
+
+/**
+ * @brief MRV backtracking for boards of any box size up to 5 (9x9, 16x16, 25x25).
+ *
+ * The size-generic counterpart of solveBoardEfficient(), with bitmask candidates. Used as
+ * the backtracking baseline for SudokuSat on large boards.
+ *
+ * @param cells size * size cells (size = box_size * box_size), row-major, 0 for empty.
+ * @param box_size Side length of a box.
+ * @param node_limit Give up after this many search nodes (0 = no limit).
+ * @param nodes If not null, receives the number of search nodes used.
+ * @return true if solved, false if there is no solution or the limit was reached
+ *         (`cells` is then unchanged).
+ */
+bool solveBoardOfSize(int* cells, const int& box_size, const long long& node_limit = 0, long long* nodes = nullptr);
+
+// ========================= Solution Enumeration =========================
+
+/**
+ * @brief Streams every solution of a Sudoku board to a callback.
+ *
+ * Walks the full search tree using findNextCell() to pick the cell with the fewest
+ * candidates. Each time the board is completely filled, `callback` is invoked with the
+ * solved board. Solutions are never stored, so memory stays constant no matter how many
+ * solutions the board has. The callback may return false to stop the enumeration early.
+ *
+ * The callback must not keep the pointer it receives: the board is reused by the search.
+ * BOARD is restored to its original state before returning.
+ *
+ * @param BOARD Pointer to a dynamically allocated 9x9 Sudoku board.
+ * @param callback Invoked with the solved board for each solution; return false to stop.
+ * @param limit Maximum number of solutions to report (0 means no limit).
+ * @return Number of solutions passed to the callback (0 if two clues clash).
+ */
+long long enumerateSolutions(int** BOARD, const std::function<bool(int**)>& callback, const long long& limit = 0);
+
+/**
+ * @brief Counts the solutions of a Sudoku board, stopping once `limit` is reached.
+ *
+ * Uses bitmask candidate sets for rows, columns and boxes and always branches on the
+ * empty cell with the fewest candidates, so it is much cheaper than enumerating with
+ * isValid(). Calling it with limit 2 answers "is this puzzle uniquely solvable?".
+ *
+ * @param BOARD Pointer to a dynamically allocated 9x9 Sudoku board (left unchanged).
+ * @param limit Stop counting after this many solutions (default 2).
+ * @return Number of solutions found, at most `limit`. 0 if the board is unsolvable.
+ */
+int countSolutions(int** BOARD, const int& limit = 2);
+
+/**
+ * @brief Multithreaded variant of enumerateSolutions().
+ *
+ * Expands the first levels of the search tree into independent sub-boards and hands
+ * them to `num_threads` workers. Calls to `callback` are serialized, so it does not need
+ * to be thread safe, but solutions arrive in no particular order. Returning false from
+ * the callback, or reaching `limit`, stops every worker.
+ *
+ * @param BOARD Pointer to a dynamically allocated 9x9 Sudoku board (left unchanged).
+ * @param callback Invoked with a solved board for each solution; return false to stop.
+ * @param limit Maximum number of solutions to report (0 means no limit).
+ * @param num_threads Number of worker threads (0 uses the hardware concurrency).
+ * @return Number of solutions passed to the callback (0 if two clues clash).
+ */
+long long enumerateSolutionsParallel(int** BOARD, const std::function<bool(int**)>& callback,
+                                     const long long& limit = 0, const int& num_threads = 0);
 
 #endif //SUDOKUPROJECT_SUDOKU_H
\ No newline at end of file
@@ -0,0 +1,83 @@
+/**
+ * @file sudoku_api.h
+ * @brief Embeddable C++ API for solving puzzles in caller-owned buffers.
+ *
+ * A board is a contiguous buffer of 81 ints in row-major order, with 0 for an empty cell
+ * and 1..9 for a digit. A batch is `count` such boards back to back. Boards are solved in
+ * place: no file I/O, no board allocation, and nothing is kept between calls except the
+ * per-thread clause database of Engine::Sat (allocated on its first use in a thread).
+ *
+ * All functions are thread safe as long as threads work on different buffers. The same
+ * API is available to C and other languages through sudoku_c.h.
+ *
+ * @date
+ * October 19, 2026
+ */
+
+#ifndef SUDOKUPROJECT_SUDOKU_API_H
+#define SUDOKUPROJECT_SUDOKU_API_H
+
+#include <cstddef>
+#include "sudoku_c.h"
+
+namespace sudoku {
+
+/**
+ * @brief Cells in one board buffer.
+ */
+const int CELLS = SUDOKU_CELLS;
+
+/**
+ * @brief Solver used for a board (see solve(int**, const SolverKind&) for their strengths).
+ */
+enum class Engine {
+    Basic = SUDOKU_ENGINE_BASIC,          ///< Row-by-row backtracking.
+    Efficient = SUDOKU_ENGINE_EFFICIENT,  ///< Fewest-candidates-first backtracking.
+    Restart = SUDOKU_ENGINE_RESTART,      ///< Random value order with Luby restarts.
+    Adaptive = SUDOKU_ENGINE_ADAPTIVE,    ///< Row-by-row with a node budget, then restarts (the default).
+    Sat = SUDOKU_ENGINE_SAT               ///< CDCL SAT solver.
+};
+
+/**
+ * @brief Outcome of solving one board.
+ */
+enum class Status {
+    Solved = SUDOKU_SOLVED,               ///< The buffer now holds the solution.
+    NoSolution = SUDOKU_NO_SOLUTION,      ///< The clues admit no solution; the buffer is unchanged.
+    InvalidInput = SUDOKU_INVALID_INPUT   ///< A cell is outside 0..9, two clues clash or the engine is unknown; the buffer is unchanged.
+};
+
+/**
+ * @brief Solves one board in place.
+ *
+ * @param cells CELLS ints, row-major, 0 for empty.
+ * @param engine Solver to use.
+ * @return Status::Solved if `cells` now holds a solution.
+ */
+SUDOKU_API Status solve(int* cells, const Engine& engine = Engine::Adaptive);
+
+/**
+ * @brief Solves `count` boards stored back to back in place.
+ *
+ * @param cells count * CELLS ints.
+ * @param count Number of boards.
+ * @param engine Solver to use.
+ * @param statuses If not null, receives the Status of every board (`count` entries).
+ * @return Number of boards solved.
+ */
+SUDOKU_API std::size_t solveBatch(int* cells, const std::size_t& count, const Engine& engine = Engine::Adaptive,
+                                  Status* statuses = nullptr);
+
+/**
+ * @brief Checks that every cell holds 0..9 and no two clues clash in a row, column or box.
+ */
+SUDOKU_API bool hasValidClues(const int* cells);
+
+/**
+ * @brief Checks that the board is completely and correctly filled.
+ */
+SUDOKU_API bool isValidSolution(const int* cells);
+
+}  // namespace sudoku
+
+#endif //SUDOKUPROJECT_SUDOKU_API_H
@@ -0,0 +1,83 @@
+/**
+ * @file sudoku_c.h
+ * @brief C ABI of the embeddable solver API.
+ *
+ * Plain C declarations of the functions in sudoku_api.h, for C programs and for foreign
+ * function interfaces (Python ctypes, Go cgo, Rust, ...). A board is a buffer of
+ * SUDOKU_CELLS ints in row-major order with 0 for an empty cell; a batch is several
+ * boards back to back. Boards are solved in place without file I/O or board allocation.
+ *
+ * @date
+ * October 19, 2026
+ */
+
+#ifndef SUDOKUPROJECT_SUDOKU_C_H
+#define SUDOKUPROJECT_SUDOKU_C_H
+
+#include <stddef.h>
+
+/* Symbols of a shared library build are exported; static builds need no decoration */
+#if defined(_WIN32) && defined(SUDOKU_SHARED)
+#  ifdef SUDOKU_BUILDING_LIBRARY
+#    define SUDOKU_API __declspec(dllexport)
+#  else
+#    define SUDOKU_API __declspec(dllimport)
+#  endif
+#elif defined(__GNUC__)
+#  define SUDOKU_API __attribute__((visibility("default")))
+#else
+#  define SUDOKU_API
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Cells in one board buffer. */
+#define SUDOKU_CELLS 81
+
+/** Solver used for a board. */
+typedef enum sudoku_engine {
+    SUDOKU_ENGINE_BASIC = 0,
+    SUDOKU_ENGINE_EFFICIENT = 1,
+    SUDOKU_ENGINE_RESTART = 2,
+    SUDOKU_ENGINE_ADAPTIVE = 3,
+    SUDOKU_ENGINE_SAT = 4
+} sudoku_engine;
+
+/** Outcome of solving one board. */
+typedef enum sudoku_status {
+    SUDOKU_SOLVED = 0,
+    SUDOKU_NO_SOLUTION = 1,
+    SUDOKU_INVALID_INPUT = 2
+} sudoku_status;
+
+/**
+ * @brief Solves one board (SUDOKU_CELLS ints) in place.
+ * @return SUDOKU_SOLVED, or SUDOKU_NO_SOLUTION / SUDOKU_INVALID_INPUT with the board unchanged.
+ */
+SUDOKU_API sudoku_status sudoku_solve(int* cells, sudoku_engine engine);
+
+/**
+ * @brief Solves `count` boards stored back to back in place.
+ *
+ * @param statuses If not NULL, receives the status of every board (`count` entries).
+ * @return Number of boards solved.
+ */
+SUDOKU_API size_t sudoku_solve_batch(int* cells, size_t count, sudoku_engine engine, sudoku_status* statuses);
+
+/**
+ * @brief Returns 1 if every cell holds 0..9 and no two clues clash, 0 otherwise.
+ */
+SUDOKU_API int sudoku_has_valid_clues(const int* cells);
+
+/**
+ * @brief Returns 1 if the board is completely and correctly filled, 0 otherwise.
+ */
+SUDOKU_API int sudoku_is_valid_solution(const int* cells);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SUDOKUPROJECT_SUDOKU_C_H */
@@ -25,7 +25,9 @@
 
 #include <vector>
 #include <string>
-using namespace std;
+#include "bounded_queue.h"
+#include "sudoku.h"
+#include "utils.h"
 
 /**
  * @brief Prints the Sudoku board to the console with highlighting.
@@ -52,18 +54,19 @@ void printBoard(int** BOARD, const int& r=0, const int& c=0, int k=0);
  * @param BOARD A pointer to the 2D Sudoku board (int**).
  * @param content Reference to a string where the board will be stored.
  */
-void boardToString(int** BOARD, string& content);
+void boardToString(int** BOARD, std::string& content);
 
 /**
  * @brief Writes the Sudoku board to a file.
  *
  * Serializes the board into a formatted string and writes it to the specified file.
+ * Missing parent folders (such as a new shard folder) are created on demand.
  *
  * @param BOARD A pointer to the 2D Sudoku board (int**).
  * @param filename Name of the file to write the board to.
  * @return true if writing was successful, false otherwise.
  */
-bool writeSudokuToFile(int** BOARD, const string& filename);
+bool writeSudokuToFile(int** BOARD, const std::string& filename);
 
 /**
  * @brief Replaces all occurrences of a character in a string.
@@ -74,7 +77,7 @@ bool writeSudokuToFile(int** BOARD, const string& filename);
  * @param oldChar The character to be replaced.
  * @param newChar The character to replace with.
  */
-void replaceCharacter(string& str, char oldChar, char newChar);
+void replaceCharacter(std::string& str, char oldChar, char newChar);
 
 /**
  * @brief Extracts integers from a string.
@@ -85,7 +88,7 @@ void replaceCharacter(string& str, char oldChar, char newChar);
  * @param input The input string to parse.
  * @param numbers A vector where extracted integers will be stored.
  */
-void extractNumbers(const string& input, vector<int>& numbers);
+void extractNumbers(const std::string& input, std::vector<int>& numbers);
 
 /**
  * @brief Fills a Sudoku board with numbers from a vector.
@@ -96,7 +99,17 @@ void extractNumbers(const string& input, vector<int>& numbers);
  * @param numbers A vector containing the numbers to fill the board.
  * @param BOARD A pointer to the 2D Sudoku board (int**) to fill.
  */
-void fillBoard(const vector<int>& numbers, int** BOARD);
+void fillBoard(const std::vector<int>& numbers, int** BOARD);
+
+/**
+ * @brief Parses a Sudoku board from the text of a puzzle file.
+ *
+ * Accepts the format written by boardToString(). Missing trailing cells are left empty.
+ *
+ * @param sudoku The contents of a puzzle file.
+ * @return A pointer to a dynamically allocated 2D Sudoku board.
+ */
+int** parseSudoku(std::string sudoku);
 
 /**
  * @brief Reads a Sudoku board from a file.
@@ -107,7 +120,7 @@ void fillBoard(const vector<int>& numbers, int** BOARD);
  * @param filename The path to the file containing the Sudoku puzzle.
  * @return A pointer to a dynamically allocated 2D Sudoku board.
  */
-int** readSudokuFromFile(const string& filename);
+int** readSudokuFromFile(const std::string& filename);
 
 /**
  * @brief Checks if the provided Sudoku board is a valid solution.
@@ -125,24 +138,87 @@ bool checkIfSolutionIsValid(int** BOARD);
 /**
  * @brief Retrieves all Sudoku puzzle filenames in a given folder.
  *
- * Scans the specified folder and returns paths to all Sudoku puzzle files.
+ * Scans the specified folder, including its shard subfolders, and returns paths to all
+ * Sudoku puzzle files. Prefer streamSudokuInFolder() for large corpora, which does not
+ * need the full listing before work can start.
  *
  * @param folderPath Path to the folder containing Sudoku puzzles.
  * @return A vector of file paths to the Sudoku puzzles.
  */
-vector<string> getAllSudokuInFolder(const string& folderPath);
+std::vector<std::string> getAllSudokuInFolder(const std::string& folderPath);
+
+/**
+ * @brief Lazily lists Sudoku puzzle files into a queue.
+ *
+ * Walks the folder and its shard subfolders and pushes each regular file's path as soon
+ * as it is found, so consumers can start on the first file while the listing continues.
+ * The queue is bounded, so listing pauses when consumers fall behind. The queue is closed
+ * when the walk is finished.
+ *
+ * @param folderPath Path to the folder containing Sudoku puzzles.
+ * @param paths Queue receiving the file paths.
+ * @return Number of paths pushed.
+ */
+long long streamSudokuInFolder(const std::string& folderPath, BoundedQueue<std::string>& paths);
 
 /**
  * @brief Generates and saves multiple Sudoku puzzles.
  *
  * Generates `num_puzzles` new Sudoku boards and saves them as text files
  * in the specified destination folder with filenames prefixed by `prefix`.
+ * Progress is shown on a single, rate-limited status line. Generation and write
+ * latencies are recorded as metrics and can be saved as a JSON report.
+ *
+ * With a `journal_file`, the puzzle index and random generator state are checkpointed
+ * (see ProgressJournal). If the run is interrupted, running it again with the same
+ * arguments continues at the last checkpoint and writes exactly the puzzles an
+ * uninterrupted run would have written. The journal is deleted when the run finishes.
  *
  * @param num_puzzles The number of puzzles to generate.
  * @param destination Folder where the puzzles will be saved.
  * @param prefix Filename prefix for the saved puzzles.
+ * @param metrics_file Path of the JSON metrics report (empty to skip it).
+ * @param journal_file Path of the progress journal (empty to run without one).
+ */
+void createAndSaveNPuzzles(const int& num_puzzles, const int& complexity_empty_boxes, const std::string& destination, const std::string& prefix,
+                           const std::string& metrics_file = "", const std::string& journal_file = "");
+
+/**
+ * @brief Generates and saves multiple minimal Sudoku puzzles.
+ *
+ * Same as createAndSaveNPuzzles(), but every board is minimal (see generateMinimalBoard()),
+ * so each saved puzzle is uniquely solvable and has no removable clue. Clue removals are
+ * tested on all hardware threads; a resumed run still produces the same puzzles.
+ *
+ * @param num_puzzles The number of puzzles to generate.
+ * @param symmetric Remove clues in rotationally symmetric pairs.
+ * @param destination Folder where the puzzles will be saved.
+ * @param prefix Filename prefix for the saved puzzles.
+ * @param metrics_file Path of the JSON metrics report (empty to skip it).
+ * @param journal_file Path of the progress journal (empty to run without one).
+ */
+void createAndSaveNMinimalPuzzles(const int& num_puzzles, const bool& symmetric, const std::string& destination, const std::string& prefix,
+                                  const std::string& metrics_file = "", const std::string& journal_file = "");
+
+/**
+ * @brief Generates puzzles for each difficulty bucket and saves them with their ratings.
+ *
+ * Fills the buckets with generateRatedPuzzles(), writes every puzzle to `destination`
+ * and writes one CSV row per puzzle to `ratings_file` with the puzzle's file name,
+ * difficulty and measured solver effort. Keep `ratings_file` outside `destination`,
+ * since every file in the puzzle folder is read back as a puzzle.
+ *
+ * Nothing is generated if `ratings_file` cannot be opened. Buckets still short of their
+ * target after `max_attempts` candidates are reported.
+ *
+ * @param targets Number of puzzles wanted per bucket, indexed by Difficulty.
+ * @param destination Folder where the puzzles will be saved.
+ * @param prefix Filename prefix for the saved puzzles.
+ * @param ratings_file Path of the CSV file receiving the ratings.
+ * @param max_attempts Maximum number of candidates to rate, so a rare bucket cannot loop forever.
  */
-void createAndSaveNPuzzles(const int& num_puzzles, const int& complexity_empty_boxes, const string& destination, const string& prefix);
+void createAndSaveRatedPuzzles(const std::vector<int>& targets, const std::string& destination, const std::string& prefix, const std::string& ratings_file,
+                               const long long& max_attempts = 20000);
 
 /**
  * @brief Solves and saves multiple Sudoku puzzles from a source folder.
@@ -150,12 +226,59 @@ void createAndSaveNPuzzles(const int& num_puzzles, const int& complexity_empty_b
  * Reads unsolved puzzles from `source`, solves them, and saves the
  * solutions to `destination` with filenames prefixed by `prefix`.
  *
+ * The folder is listed lazily by streamSudokuInFolder() on its own thread. A reader
+ * thread reads the listed files in batches with BatchFileIO (io_uring where available)
+ * and hands the parsed boards to `num_threads` workers, which solve and validate them; a
+ * writer thread writes the solutions in batches, so file I/O overlaps with solving. Each
+ * solution keeps the index of its puzzle file and is written to the sharded layout of
+ * getShardedFileName(). Read and write latencies are per file, averaged over the batch.
+ *
+ * Progress is shown on a single, rate-limited status line. Read, solve, validate and
+ * write latencies are recorded per stage, printed as a summary with p50/p99/p999 and
+ * optionally saved as a JSON report.
+ *
+ * With a `shard` of N > 1, only the puzzles owned by that shard (see isInShard()) are
+ * solved, and the metrics report gets a `.shard-k-of-N` tag (see getShardFileName()).
+ * Since solutions keep their puzzle's index, shards writing to the same folder never
+ * collide; mergeShardResults() combines their outputs and reports.
+ *
+ * With a `journal_file` (tagged per shard like the metrics report), every puzzle whose
+ * solution was written, or that has no solution, is journaled in batches. Running the
+ * same command again after an interruption skips the journaled puzzles; since solving is
+ * deterministic, the output is the same as that of an uninterrupted run. Puzzles whose
+ * file could not be read or written are not journaled, and the journal is kept after a
+ * run that left any of them, so running again retries just those. Otherwise the journal
+ * is deleted when the run finishes.
+ *
  * @param num_puzzles The number of puzzles to solve.
  * @param source Folder containing unsolved puzzles.
  * @param destination Folder where solved puzzles will be saved.
  * @param prefix Filename prefix for the saved solutions.
+ * @param metrics_file Path of the JSON metrics report (empty to skip it).
+ * @param num_threads Number of solver threads (0 uses the hardware concurrency).
+ * @param shard Part of the corpus to solve (the whole corpus if not provided).
+ * @param journal_file Path of the progress journal (empty to run without one).
  */
-void solveAndSaveNPuzzles(const int& num_puzzles, const string& source, const string& destination, const string& prefix);
+void solveAndSaveNPuzzles(const int& num_puzzles, const std::string& source, const std::string& destination, const std::string& prefix,
+                          const std::string& metrics_file = "", const int& num_threads = 0, const ShardSpec& shard = ShardSpec(),
+                          const std::string& journal_file = "");
+
+/**
+ * @brief Combines the outputs of a run split with `--shard k/N` into one corpus and one report.
+ *
+ * Copies every file under each of `shard_folders` into `destination`, keeping the shard
+ * subfolders, and merges the N per-shard metrics reports (`metrics_file` tagged with
+ * getShardFileName()) into `metrics_file`. Shards that wrote straight into `destination`
+ * need no copy, so `shard_folders` may be empty when all shards ran on one machine.
+ *
+ * @param shard_count Number of shards N the run was split into.
+ * @param shard_folders Solution folders produced by the shards (e.g. copied from other machines).
+ * @param destination Folder receiving the merged corpus.
+ * @param metrics_file Path of the merged JSON report (empty to skip merging metrics).
+ * @return true if the report of every shard was found and merged.
+ */
+bool mergeShardResults(const int& shard_count, const std::vector<std::string>& shard_folders, const std::string& destination,
+                       const std::string& metrics_file);
 
 /**
  * @brief Performs a deep copy of a 9x9 Sudoku board.
@@ -166,14 +289,81 @@ void solveAndSaveNPuzzles(const int& num_puzzles, const string& source, const st
 int** deepCopyBoard(int** original);
 
 /**
- * @brief Compares the performance of solveBoard and efficientSolveBoard.
+ * @brief Copies a 9x9 Sudoku board into an existing board without allocating.
  *
- * Runs both solvers multiple times on generated Sudoku boards and prints
- * the average runtime for each solver.
+ * @param source The board to copy from.
+ * @param destination The already allocated board to overwrite.
+ */
+void copyBoard(int** source, int** destination);
+
+/**
+ * @brief Compares the performance of the available Sudoku solvers.
+ *
+ * Runs every solver (solveBoard, solveBoardEfficient, solveBoardWithOptions with
+ * random value order and Luby restarts, the adaptive solve() and the CDCL SAT solver) on the same generated Sudoku boards and
+ * prints the average and p50/p99/p999 runtime for each solver. Progress is printed by a
+ * background status line instead of inside the timed loop.
+ *
+ * Every puzzle is also rated with rateBoard(), and each solver gets a series per
+ * difficulty band (e.g. "cdcl/hard"). With `hardware_counters`, cycles, instructions,
+ * branch misses and L1D/LLC misses of every solver call are read with PerfCounters and
+ * reported per band as means per solve, in the summary and in the JSON report. Where the
+ * counters are unavailable, the reason is printed and only times are reported.
  *
  * @param experiment_size Number of experiments to run.
  * @param empty_boxes Number of empty cells in the generated Sudoku board.
+ * @param metrics_file Path of the JSON metrics report (empty to skip it).
+ * @param hardware_counters Count hardware events around every solver call.
+ */
+void compareSudokuSolvers(const int& experiment_size, const int& empty_boxes, const std::string& metrics_file = "",
+                          const bool& hardware_counters = true);
+
+/**
+ * @brief Compares MRV backtracking and the CDCL SAT solver on boards of any size.
+ *
+ * Generates `experiment_size` boards with generateBoardOfSize() and solves each with
+ * solveBoardOfSize() and with one SudokuSat, which is encoded once and reused for every
+ * board. Prints mean, p50, p99 and max times, valid solutions and search effort.
+ * Backtracking runs that reach `node_limit` count as failures.
+ *
+ * @param box_size Side length of a box (3 for 9x9, 4 for 16x16, 5 for 25x25).
+ * @param experiment_size Number of boards to solve.
+ * @param empty_cells Number of empty cells per board.
+ * @param node_limit Search nodes before backtracking gives up on a board (0 = no limit).
+ * @param metrics_file Path of the JSON metrics report (empty to skip it).
+ */
+void compareLargeSudokuSolvers(const int& box_size, const int& experiment_size, const int& empty_cells,
+                               const long long& node_limit = 1000000, const std::string& metrics_file = "");
+
+/**
+ * @brief Measures the thresholds solveAdaptive() should use on this machine.
+ *
+ * For every generator empty-box count from 20 to 64 in steps of 4, generates
+ * `experiment_size` puzzles and times solveAdaptive() once with every puzzle forced to the
+ * budgeted row-by-row search and once forced to the restart solver. Puzzles are grouped
+ * in buckets of 5 by the empty cells left after naked singles (DispatchDecision::empty),
+ * which is the count solveAdaptive() compares with sequential_max_empty; puzzles that
+ * naked singles solve are skipped. The returned sequential_max_empty is the top of the
+ * last bucket up to which the row-by-row search has the lower mean time, or 81 if it is
+ * ahead in every bucket. The current
+ * thresholds are left unchanged; pass the result to setDispatchThresholds() to use it.
+ *
+ * @param experiment_size Number of puzzles per empty-box count (0 returns the current thresholds).
+ * @return The calibrated thresholds.
+ */
+DispatchThresholds calibrateSolverDispatch(const int& experiment_size);
+
+/**
+ * @brief Stress-tests the memory of many live SudokuSession objects.
+ *
+ * For `steps` evenly spaced counts up to `max_sessions`, keeps that many sessions in one
+ * array, asks every session for a hint and plays it, and measures how much the resident
+ * set size grew. Prints the growth per session next to SESSION_BYTES, so a linear and
+ * predictable footprint shows up as the same bytes per session at every count.
+ *
+ * @param max_sessions Sessions kept live in the largest step.
+ * @param steps Number of session counts to measure.
  */
-void compareSudokuSolvers(const int& experiment_size, const int& empty_boxes);
+void measureSessionMemory(const int& max_sessions, const int& steps = 5);
 
 #endif //SUDOKUPROJECT_SUDOKUIO_H
\ No newline at end of file
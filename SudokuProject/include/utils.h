@@ -6,6 +6,7 @@
  * - Allocate and deallocate dynamic Sudoku boards.
  * - Manage folders for storing Sudoku puzzles and solutions.
  * - Generate formatted filenames for Sudoku puzzles.
+ * - Read the resident memory of the process.
  *
  * These utilities are designed to support file I/O operations, board memory management,
  * and folder structure initialization for Sudoku puzzle generation and solving projects.
@@ -21,7 +22,6 @@
 #define SUDOKUPROJECT_UTILITY_H
 
 #include <string>
-using namespace std;
 
 /**
   * @brief Deallocates a dynamically allocated 2D integer array.
@@ -41,7 +41,7 @@ void deallocateBoard(int** BOARD, const int& rows = 9);
  *
  * @param folderPath The path where the folder should be created.
  */
-void createFolder(const string& folderPath);
+void createFolder(const std::string& folderPath);
 
 /**
  * @brief Initializes the folder structure for Sudoku data storage.
@@ -56,13 +56,93 @@ void initDataFolder();
  *
  * Constructs a filename using a zero-padded index, a destination path, and a prefix.
  * The filename follows the pattern: `destination/XXXXprefix.txt`, where `XXXX` is the
- * zero-padded index (e.g., `0001puzzle.txt`).
+ * index zero-padded to at least 4 digits (e.g., `0001puzzle.txt`, `12345puzzle.txt`).
  *
  * @param index The numerical index to include in the filename.
  * @param destination The directory where the file will be saved.
  * @param prefix The filename prefix (e.g., "puzzle" or "solution").
  * @return A formatted string representing the complete file path.
  */
-string getFileName(const int& index, const string& destination, const string& prefix);
+std::string getFileName(const int& index, const std::string& destination, const std::string& prefix);
+
+/**
+ * @brief Number of puzzle files stored in each shard folder.
+ */
+const int FILES_PER_SHARD = 1000;
+
+/**
+ * @brief Generates a filename inside an index-based shard folder.
+ *
+ * Keeps folders small for very large corpora by placing every FILES_PER_SHARD
+ * consecutive indices in their own subfolder. The pattern is
+ * `destination/SSSS/XXXXprefix.txt`, where `SSSS` is index / FILES_PER_SHARD and `XXXX`
+ * is the index, both zero-padded to at least 4 digits (e.g., `0012/12345puzzle.txt`).
+ * The shard folder is created by writeSudokuToFile() when it is first written to.
+ *
+ * @param index The numerical index to include in the filename.
+ * @param destination The directory where the shard folders live.
+ * @param prefix The filename prefix (e.g., "puzzle" or "solution").
+ * @return A formatted string representing the complete file path.
+ */
+std::string getShardedFileName(const int& index, const std::string& destination, const std::string& prefix);
+
+/**
+ * @brief Extracts the puzzle index from a filename produced by getFileName().
+ *
+ * @param path Path of a puzzle file, e.g. `data/puzzles/0012/12345PUZZLE.txt`.
+ * @return The leading number of the file name (12345), or -1 if it has none.
+ */
+int getIndexFromFileName(const std::string& path);
+
+/**
+ * @brief One part of a corpus split across processes or machines (`--shard k/N`).
+ *
+ * Shard `index` of `count` owns every puzzle whose key modulo `count` equals `index`.
+ * The key is the puzzle's file index, or a hash of its file name when `by_hash` is set
+ * or the name has no index. Every puzzle belongs to exactly one shard, and the split
+ * depends only on the file names, so all shards agree without talking to each other.
+ */
+struct ShardSpec {
+    int index = 0;
+    int count = 1;
+    bool by_hash = false;
+};
+
+/**
+ * @brief Parses a shard given as `k/N` (split by index) or `k/N:hash` (split by hash).
+ *
+ * @param text The shard text, e.g. "2/8".
+ * @param shard Receives the parsed shard.
+ * @return true if the text is valid (0 <= k < N), false otherwise.
+ */
+bool parseShardSpec(const std::string& text, ShardSpec& shard);
+
+/**
+ * @brief Checks whether a puzzle file belongs to a shard.
+ *
+ * @param shard The shard to test against.
+ * @param path Path of the puzzle file.
+ * @return true if the shard owns the file.
+ */
+bool isInShard(const ShardSpec& shard, const std::string& path);
+
+/**
+ * @brief Adds a `.shard-k-of-N` tag before the extension of a file name.
+ *
+ * Used to give every shard its own metrics report, e.g.
+ * `data/solve_metrics.json` -> `data/solve_metrics.shard-2-of-8.json`.
+ * A single-shard spec leaves the name unchanged.
+ */
+std::string getShardFileName(const std::string& filename, const ShardSpec& shard);
+
+/**
+ * @brief Resident set size of the current process in bytes.
+ *
+ * Read from /proc/self/statm, so it counts the pages actually in memory rather than
+ * reserved address space.
+ *
+ * @return The resident bytes, or -1 where /proc/self/statm is unavailable.
+ */
+long long residentSetBytes();
 
 #endif //SUDOKUPROJECT_UTILITY_H
\ No newline at end of file
@@ -2,6 +2,7 @@
 #include "include/sudoku.h"
 #include "include/sudoku_io.h"
 #include "include/utils.h"
+#include "include/pipeline.h"
 #include <iostream>
 
 using namespace std;
@@ -11,6 +12,12 @@ using namespace std;
 
 string PATH_TO_PUZZLES = "data/puzzles/";
 string PATH_TO_SOLUTIONS = "data/solutions/";
+string PATH_TO_RATINGS = "data/ratings.csv";
+string PATH_TO_METRICS = "data/";
+
+// Progress journals; an interrupted run started again continues where it stopped
+string PATH_TO_CREATE_JOURNAL = "data/create.journal";
+string PATH_TO_SOLVE_JOURNAL = "data/solve.journal";
 
 string PUZZLE_PREFIX = "PUZZLE";
 string SOLUTION_PREFIX = "SOLUTION";
@@ -19,6 +26,20 @@ int NUM_PUZZLE_TO_GENERATE = 10;
 
 int COMPLEXITY_EMPTY_BOXES = 45;
 
+// Generate minimal, uniquely solvable puzzles instead of removing COMPLEXITY_EMPTY_BOXES cells
+bool GENERATE_MINIMAL_PUZZLES = false;
+bool SYMMETRIC_MINIMAL_PUZZLES = false;
+
+// Generate puzzles rated by solver effort, DIFFICULTY_TARGETS[d] puzzles per Difficulty bucket
+bool GENERATE_RATED_PUZZLES = false;
+vector<int> DIFFICULTY_TARGETS = {3, 3, 2, 2};
+
+// Generate, solve and validate in memory through the threaded pipeline instead of via data/
+bool RUN_PIPELINE = false;
+bool PIPELINE_PERSIST = false;
+int PIPELINE_SOLVER_WORKERS = 2;
+int PIPELINE_QUEUE_CAPACITY = 256;
+
 #ifdef DEBUG_MODE
 /**
  * @brief Debug main function for testing and experimenting.
@@ -60,19 +81,76 @@ int main() {
 /**
  * @brief Main function for production use.
  *
- * Generates, solves, and compares Sudoku puzzles.
+ * Generates, solves, and compares Sudoku puzzles. A corpus can also be split across
+ * processes or machines:
+ * - `--generate` only generates the puzzles.
+ * - `--shard k/N` (or `k/N:hash`) only solves shard k of N, see ShardSpec.
+ * - `--merge N [folder...]` merges the shards' solution folders and metrics reports.
  */
-int main() {
+int main(int argc, char** argv) {
+    vector<string> args(argv + 1, argv + argc);
+    ShardSpec shard;
+    if (args.size() >= 2 && args[0] == "--shard") {
+        if (!parseShardSpec(args[1], shard)) {
+            cerr << "Invalid shard \"" << args[1] << "\", expected k/N or k/N:hash with 0 <= k < N" << endl;
+            return 1;
+        }
+        initDataFolder();
+        solveAndSaveNPuzzles(NUM_PUZZLE_TO_GENERATE, PATH_TO_PUZZLES, PATH_TO_SOLUTIONS, SOLUTION_PREFIX,
+                             PATH_TO_METRICS + "solve_metrics.json", 0, shard, PATH_TO_SOLVE_JOURNAL);
+        return 0;
+    }
+    if (args.size() >= 2 && args[0] == "--merge") {
+        int shard_count = atoi(args[1].c_str());
+        if (shard_count < 1) {
+            cerr << "Invalid shard count \"" << args[1] << "\"" << endl;
+            return 1;
+        }
+        vector<string> folders(args.begin() + 2, args.end());
+        return mergeShardResults(shard_count, folders, PATH_TO_SOLUTIONS, PATH_TO_METRICS + "solve_metrics.json") ? 0 : 1;
+    }
+    bool generate_only = !args.empty() && args[0] == "--generate";
+
     initDataFolder();
-    createAndSaveNPuzzles(NUM_PUZZLE_TO_GENERATE, COMPLEXITY_EMPTY_BOXES, PATH_TO_PUZZLES, PUZZLE_PREFIX);
-    solveAndSaveNPuzzles(NUM_PUZZLE_TO_GENERATE, PATH_TO_PUZZLES, PATH_TO_SOLUTIONS, SOLUTION_PREFIX);
+    if (RUN_PIPELINE) {
+        PipelineConfig config;
+        config.num_puzzles = NUM_PUZZLE_TO_GENERATE;
+        config.empty_boxes = COMPLEXITY_EMPTY_BOXES;
+        config.solver_workers = PIPELINE_SOLVER_WORKERS;
+        config.queue_capacity = PIPELINE_QUEUE_CAPACITY;
+        config.persist = PIPELINE_PERSIST;
+        config.puzzle_destination = PATH_TO_PUZZLES;
+        config.solution_destination = PATH_TO_SOLUTIONS;
+        config.puzzle_prefix = PUZZLE_PREFIX;
+        config.solution_prefix = SOLUTION_PREFIX;
+        printPipelineReport(runPipeline(config));
+        return 0;
+    }
+    if (GENERATE_RATED_PUZZLES)
+        createAndSaveRatedPuzzles(DIFFICULTY_TARGETS, PATH_TO_PUZZLES, PUZZLE_PREFIX, PATH_TO_RATINGS);
+    else if (GENERATE_MINIMAL_PUZZLES)
+        createAndSaveNMinimalPuzzles(NUM_PUZZLE_TO_GENERATE, SYMMETRIC_MINIMAL_PUZZLES, PATH_TO_PUZZLES, PUZZLE_PREFIX,
+                                     PATH_TO_METRICS + "create_metrics.json", PATH_TO_CREATE_JOURNAL);
+    else
+        createAndSaveNPuzzles(NUM_PUZZLE_TO_GENERATE, COMPLEXITY_EMPTY_BOXES, PATH_TO_PUZZLES, PUZZLE_PREFIX,
+                              PATH_TO_METRICS + "create_metrics.json", PATH_TO_CREATE_JOURNAL);
+    if (generate_only) return 0;
+    solveAndSaveNPuzzles(NUM_PUZZLE_TO_GENERATE, PATH_TO_PUZZLES, PATH_TO_SOLUTIONS, SOLUTION_PREFIX,
+                         PATH_TO_METRICS + "solve_metrics.json", 0, ShardSpec(), PATH_TO_SOLVE_JOURNAL);
 
     // Run experiments to compare solvers
-    compareSudokuSolvers(10, 64);
+    compareSudokuSolvers(10, 64, PATH_TO_METRICS + "compare_metrics.json");
     //compareSudokuSolvers(100, 45);
     //compareSudokuSolvers(1000, 32);
     //compareSudokuSolvers(10000, 16);
 
+    // CDCL against MRV backtracking on 16x16 and 25x25 boards
+    //compareLargeSudokuSolvers(4, 30, 150);
+    //compareLargeSudokuSolvers(5, 10, 350);
+
+    // Memory of many live interactive sessions
+    //measureSessionMemory(500000);
+
     return 0;
 }
 #endif
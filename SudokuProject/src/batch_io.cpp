@@ -0,0 +1,472 @@
+/**
+ * @file batch_io.cpp
+ * @brief Implementation of batched file reads and writes over io_uring.
+ *
+ * Detailed function descriptions are provided in the corresponding header file.
+ *
+ * @date
+ * October 19, 2026
+ */
+
+#include "../include/batch_io.h"
+#include <climits>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <thread>
+
+#if defined(__linux__) && __has_include(<linux/io_uring.h>)
+#define SUDOKU_HAVE_IO_URING 1
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+/**
+ * Bytes read by the batched read of a file; larger files are finished by blocking reads.
+ * A saved 9x9 puzzle is about 200 bytes.
+ */
+static const size_t FILE_CHUNK = 4096;
+
+#ifdef SUDOKU_HAVE_IO_URING
+
+/**
+ * The mapped submission and completion rings of one io_uring.
+ */
+struct IoRing {
+    int fd = -1;
+    unsigned entries = 0;
+    void* sq_ptr = MAP_FAILED;
+    size_t sq_size = 0;
+    void* cq_ptr = MAP_FAILED;
+    size_t cq_size = 0;
+    io_uring_sqe* sqes = (io_uring_sqe*) MAP_FAILED;
+    size_t sqes_size = 0;
+    unsigned* sq_head = nullptr;
+    unsigned* sq_tail = nullptr;
+    unsigned* sq_mask = nullptr;
+    unsigned* sq_array = nullptr;
+    unsigned* cq_head = nullptr;
+    unsigned* cq_tail = nullptr;
+    unsigned* cq_mask = nullptr;
+    io_uring_cqe* cqes = nullptr;
+
+    ~IoRing() {
+        if (sqes != MAP_FAILED) munmap(sqes, sqes_size);
+        if (cq_ptr != MAP_FAILED && cq_ptr != sq_ptr) munmap(cq_ptr, cq_size);
+        if (sq_ptr != MAP_FAILED) munmap(sq_ptr, sq_size);
+        if (fd >= 0) close(fd);
+    }
+};
+
+/**
+ * Checks that the kernel supports every operation a batch uses (openat, read, write and
+ * close need Linux 5.6).
+ */
+static bool supportsFileOps(const int& ring_fd)
+{
+    size_t size = sizeof(io_uring_probe) + 256 * sizeof(io_uring_probe_op);
+    vector<unsigned char> buffer(size, 0);
+    io_uring_probe* probe = (io_uring_probe*) buffer.data();
+    if (syscall(__NR_io_uring_register, ring_fd, IORING_REGISTER_PROBE, probe, 256) < 0) return false;
+    for (int op : {IORING_OP_OPENAT, IORING_OP_READ, IORING_OP_WRITE, IORING_OP_CLOSE}) {
+        if (op > probe->last_op || !(probe->ops[op].flags & IO_URING_OP_SUPPORTED)) return false;
+    }
+    return true;
+}
+
+/**
+ * Creates and maps an io_uring, or returns nullptr if the kernel does not allow it.
+ */
+static IoRing* setupRing(const int& queue_depth)
+{
+    io_uring_params params;
+    memset(&params, 0, sizeof(params));
+    int fd = (int) syscall(__NR_io_uring_setup, queue_depth > 0 ? queue_depth : 1, &params);
+    if (fd < 0) return nullptr;
+
+    IoRing* ring = new IoRing();
+    ring->fd = fd;
+    ring->entries = params.sq_entries;
+    if (!supportsFileOps(fd)) {
+        delete ring;
+        return nullptr;
+    }
+
+    ring->sq_size = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    ring->cq_size = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+    bool single_mmap = params.features & IORING_FEAT_SINGLE_MMAP;
+    if (single_mmap) ring->sq_size = ring->cq_size = max(ring->sq_size, ring->cq_size);
+
+    ring->sq_ptr = mmap(nullptr, ring->sq_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQ_RING);
+    if (ring->sq_ptr == MAP_FAILED) {
+        delete ring;
+        return nullptr;
+    }
+    ring->cq_ptr = single_mmap ? ring->sq_ptr
+                 : mmap(nullptr, ring->cq_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_CQ_RING);
+    ring->sqes_size = params.sq_entries * sizeof(io_uring_sqe);
+    ring->sqes = (io_uring_sqe*) mmap(nullptr, ring->sqes_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQES);
+    if (ring->cq_ptr == MAP_FAILED || ring->sqes == MAP_FAILED) {
+        delete ring;
+        return nullptr;
+    }
+
+    char* sq = (char*) ring->sq_ptr;
+    char* cq = (char*) ring->cq_ptr;
+    ring->sq_head = (unsigned*) (sq + params.sq_off.head);
+    ring->sq_tail = (unsigned*) (sq + params.sq_off.tail);
+    ring->sq_mask = (unsigned*) (sq + params.sq_off.ring_mask);
+    ring->sq_array = (unsigned*) (sq + params.sq_off.array);
+    ring->cq_head = (unsigned*) (cq + params.cq_off.head);
+    ring->cq_tail = (unsigned*) (cq + params.cq_off.tail);
+    ring->cq_mask = (unsigned*) (cq + params.cq_off.ring_mask);
+    ring->cqes = (io_uring_cqe*) (cq + params.cq_off.cqes);
+    return ring;
+}
+
+/**
+ * Consecutive EAGAIN or EBUSY refusals of io_uring_enter() tolerated before the ring is
+ * given up.
+ */
+static const int ENTER_RETRIES = 100;
+
+/**
+ * Moves every completion waiting in the completion ring into `results`.
+ * @return Number of completions reaped.
+ */
+static unsigned reapCompletions(IoRing& ring, vector<int>& results)
+{
+    unsigned head = *ring.cq_head;
+    unsigned ready = __atomic_load_n(ring.cq_tail, __ATOMIC_ACQUIRE);
+    unsigned reaped = 0;
+    while (head != ready) {
+        io_uring_cqe* cqe = &ring.cqes[head & *ring.cq_mask];
+        results[cqe->user_data] = cqe->res;
+        head++;
+        reaped++;
+    }
+    __atomic_store_n(ring.cq_head, head, __ATOMIC_RELEASE);
+    return reaped;
+}
+
+/**
+ * Submits the operations `ops` (indices into `results`), prepared by `prepare(sqe, i)`,
+ * as few system calls as possible, and waits for all of them. Each result (a file
+ * descriptor, a byte count or -errno) is stored in `results[i]`.
+ *
+ * EINTR, EAGAIN and EBUSY from io_uring_enter() are retried. Any other error, or too many
+ * retries, leaves the ring unusable: entries the kernel has not consumed are taken back,
+ * the operations already submitted are waited for (their buffers must outlive them),
+ * and every operation that never ran gets -ECANCELED.
+ *
+ * @return false if the ring failed and must not be used again.
+ */
+template <typename Prepare>
+static bool runBatch(IoRing& ring, const vector<size_t>& ops, vector<int>& results, Prepare prepare)
+{
+    for (size_t i : ops) results[i] = -ECANCELED;
+    for (size_t begin = 0; begin < ops.size(); begin += ring.entries) {
+        unsigned count = (unsigned) min<size_t>(ring.entries, ops.size() - begin);
+        unsigned tail = *ring.sq_tail;
+        unsigned mask = *ring.sq_mask;
+        for (unsigned j = 0; j < count; j++) {
+            unsigned slot = (tail + j) & mask;
+            io_uring_sqe* sqe = &ring.sqes[slot];
+            memset(sqe, 0, sizeof(*sqe));
+            prepare(sqe, ops[begin + j]);
+            sqe->user_data = ops[begin + j];
+            ring.sq_array[slot] = slot;
+            results[ops[begin + j]] = INT_MIN;
+        }
+        __atomic_store_n(ring.sq_tail, tail + count, __ATOMIC_RELEASE);
+
+        unsigned to_submit = count;
+        unsigned reaped = 0;
+        int retries = 0;
+        int error = 0;
+        while (reaped < count) {
+            long entered = syscall(__NR_io_uring_enter, ring.fd, to_submit, count - reaped, IORING_ENTER_GETEVENTS, nullptr, 0);
+            if (entered < 0) {
+                error = errno;
+                if (error == EINTR) continue;
+                if ((error == EAGAIN || error == EBUSY) && ++retries <= ENTER_RETRIES) {
+                    // Out of kernel resources or completions backed up: free the completion
+                    // ring and try again
+                    reaped += reapCompletions(ring, results);
+                    this_thread::yield();
+                    continue;
+                }
+                break;
+            }
+            retries = 0;
+            to_submit -= min<unsigned>(to_submit, (unsigned) entered);
+            reaped += reapCompletions(ring, results);
+        }
+        if (reaped == count) continue;
+
+        // The ring failed: take back the entries the kernel never consumed, so they cannot
+        // run later, then wait for every operation it did consume
+        unsigned consumed = __atomic_load_n(ring.sq_head, __ATOMIC_ACQUIRE) - tail;
+        __atomic_store_n(ring.sq_tail, tail + consumed, __ATOMIC_RELEASE);
+        while (reaped < consumed) {
+            syscall(__NR_io_uring_enter, ring.fd, 0, consumed - reaped, IORING_ENTER_GETEVENTS, nullptr, 0);
+            unsigned got = reapCompletions(ring, results);
+            if (got == 0) this_thread::yield();
+            reaped += got;
+        }
+        for (size_t i : ops) {
+            if (results[i] == INT_MIN) results[i] = -ECANCELED;
+        }
+        cerr << "io_uring failed (" << strerror(error) << "), switching to blocking file I/O" << endl;
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Closes every open descriptor in `fds` with one batch; a failed close fails its job.
+ * Descriptors the ring closed are set to -1, so after a ring failure the ones left
+ * open can still be closed directly.
+ *
+ * @return false if the ring failed.
+ */
+static bool closeBatch(IoRing& ring, vector<FileJob>& jobs, const size_t& first,
+                       vector<int>& fds, vector<int>& results)
+{
+    vector<size_t> ops;
+    for (size_t i = 0; i < fds.size(); i++) {
+        if (fds[i] >= 0) ops.push_back(i);
+    }
+    bool ring_ok = runBatch(ring, ops, results, [&](io_uring_sqe* sqe, size_t i) {
+        sqe->opcode = IORING_OP_CLOSE;
+        sqe->fd = fds[i];
+    });
+    for (size_t i : ops) {
+        if (results[i] == -ECANCELED) continue;
+        fds[i] = -1;
+        if (results[i] < 0) jobs[first + i].ok = false;
+    }
+    return ring_ok;
+}
+
+void BatchFileIO::dropRing() {
+    for (int& fd : fds_) {
+        if (fd >= 0) close(fd);
+        fd = -1;
+    }
+    delete ring_;
+    ring_ = nullptr;
+}
+
+int BatchFileIO::readRing(vector<FileJob>& jobs, const size_t& first, const size_t& last) {
+    size_t count = last - first;
+    fds_.assign(count, -1);
+    results_.assign(count, 0);
+    vector<size_t> ops;
+    for (size_t i = 0; i < count; i++) ops.push_back(i);
+
+    bool ring_ok = runBatch(*ring_, ops, results_, [&](io_uring_sqe* sqe, size_t i) {
+        sqe->opcode = IORING_OP_OPENAT;
+        sqe->fd = AT_FDCWD;
+        sqe->addr = (unsigned long long) jobs[first + i].path.c_str();
+        sqe->open_flags = O_RDONLY | O_CLOEXEC;
+    });
+    if (!ring_ok) {
+        for (size_t i = 0; i < count; i++) fds_[i] = results_[i] >= 0 ? results_[i] : -1;
+        dropRing();
+        return readBlocking(jobs, first, last);
+    }
+    ops.clear();
+    for (size_t i = 0; i < count; i++) {
+        FileJob& job = jobs[first + i];
+        job.ok = false;
+        job.data.clear();
+        if (results_[i] < 0) continue;
+        fds_[i] = results_[i];
+        job.data.resize(FILE_CHUNK);
+        ops.push_back(i);
+    }
+
+    ring_ok = runBatch(*ring_, ops, results_, [&](io_uring_sqe* sqe, size_t i) {
+        sqe->opcode = IORING_OP_READ;
+        sqe->fd = fds_[i];
+        sqe->addr = (unsigned long long) &jobs[first + i].data[0];
+        sqe->len = FILE_CHUNK;
+        sqe->off = 0;
+    });
+    if (!ring_ok) {
+        dropRing();
+        return readBlocking(jobs, first, last);
+    }
+    for (size_t i : ops) {
+        FileJob& job = jobs[first + i];
+        if (results_[i] < 0) {
+            job.data.clear();
+            continue;
+        }
+        size_t size = (size_t) results_[i];
+        job.ok = true;
+        // The chunk was filled: the file is larger than a puzzle, read the rest directly
+        while (size == job.data.size()) {
+            job.data.resize(size * 2);
+            ssize_t got = pread(fds_[i], &job.data[size], job.data.size() - size, (off_t) size);
+            if (got < 0) job.ok = false;
+            if (got <= 0) break;
+            size += (size_t) got;
+        }
+        job.data.resize(size);
+    }
+
+    if (!closeBatch(*ring_, jobs, first, fds_, results_)) dropRing();
+    int done = 0;
+    for (size_t i = first; i < last; i++) done += jobs[i].ok;
+    return done;
+}
+
+int BatchFileIO::writeRing(vector<FileJob>& jobs, const size_t& first, const size_t& last) {
+    size_t count = last - first;
+    fds_.assign(count, -1);
+    results_.assign(count, 0);
+    vector<size_t> ops;
+    for (size_t i = 0; i < count; i++) ops.push_back(i);
+
+    const int flags = O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC;
+    bool ring_ok = runBatch(*ring_, ops, results_, [&](io_uring_sqe* sqe, size_t i) {
+        sqe->opcode = IORING_OP_OPENAT;
+        sqe->fd = AT_FDCWD;
+        sqe->addr = (unsigned long long) jobs[first + i].path.c_str();
+        sqe->open_flags = flags;
+        sqe->len = 0644;
+    });
+    if (!ring_ok) {
+        for (size_t i = 0; i < count; i++) fds_[i] = results_[i] >= 0 ? results_[i] : -1;
+        dropRing();
+        return writeBlocking(jobs, first, last);
+    }
+    ops.clear();
+    for (size_t i = 0; i < count; i++) {
+        FileJob& job = jobs[first + i];
+        job.ok = false;
+        int fd = results_[i];
+        if (fd == -ENOENT) {
+            // The shard folder may not exist yet; create it and try once more
+            error_code ec;
+            filesystem::create_directories(filesystem::path(job.path).parent_path(), ec);
+            fd = open(job.path.c_str(), flags, 0644);
+        }
+        if (fd < 0) continue;
+        fds_[i] = fd;
+        ops.push_back(i);
+    }
+
+    ring_ok = runBatch(*ring_, ops, results_, [&](io_uring_sqe* sqe, size_t i) {
+        sqe->opcode = IORING_OP_WRITE;
+        sqe->fd = fds_[i];
+        sqe->addr = (unsigned long long) jobs[first + i].data.data();
+        sqe->len = (unsigned) jobs[first + i].data.size();
+        sqe->off = 0;
+    });
+    if (!ring_ok) {
+        dropRing();
+        return writeBlocking(jobs, first, last);
+    }
+    for (size_t i : ops) {
+        FileJob& job = jobs[first + i];
+        if (results_[i] < 0) continue;
+        size_t size = (size_t) results_[i];
+        // Finish a short write directly
+        while (size < job.data.size()) {
+            ssize_t put = pwrite(fds_[i], job.data.data() + size, job.data.size() - size, (off_t) size);
+            if (put <= 0) break;
+            size += (size_t) put;
+        }
+        job.ok = size == job.data.size();
+    }
+
+    if (!closeBatch(*ring_, jobs, first, fds_, results_)) dropRing();
+    int done = 0;
+    for (size_t i = first; i < last; i++) done += jobs[i].ok;
+    return done;
+}
+
+BatchFileIO::BatchFileIO(const int& queue_depth, const bool& use_io_uring) {
+    if (use_io_uring) ring_ = setupRing(queue_depth);
+}
+
+BatchFileIO::~BatchFileIO() {
+    delete ring_;
+}
+
+#else
+
+struct IoRing {};
+
+int BatchFileIO::readRing(vector<FileJob>& jobs, const size_t& first, const size_t& last) {
+    return readBlocking(jobs, first, last);
+}
+
+int BatchFileIO::writeRing(vector<FileJob>& jobs, const size_t& first, const size_t& last) {
+    return writeBlocking(jobs, first, last);
+}
+
+void BatchFileIO::dropRing() {}
+
+BatchFileIO::BatchFileIO(const int&, const bool&) {}
+
+BatchFileIO::~BatchFileIO() {
+    delete ring_;
+}
+
+#endif
+
+bool BatchFileIO::usingIoUring() const {
+    return ring_ != nullptr;
+}
+
+const char* BatchFileIO::backendName() const {
+    return ring_ ? "io_uring" : "blocking";
+}
+
+int BatchFileIO::readFiles(vector<FileJob>& jobs) {
+    return ring_ ? readRing(jobs, 0, jobs.size()) : readBlocking(jobs, 0, jobs.size());
+}
+
+int BatchFileIO::writeFiles(vector<FileJob>& jobs) {
+    return ring_ ? writeRing(jobs, 0, jobs.size()) : writeBlocking(jobs, 0, jobs.size());
+}
+
+int BatchFileIO::readBlocking(vector<FileJob>& jobs, const size_t& first, const size_t& last) {
+    int done = 0;
+    for (size_t i = first; i < last; i++) {
+        FileJob& job = jobs[i];
+        ifstream file(job.path, ios::binary);
+        job.ok = file.is_open();
+        job.data = job.ok ? string(istreambuf_iterator<char>(file), istreambuf_iterator<char>()) : string();
+        done += job.ok;
+    }
+    return done;
+}
+
+int BatchFileIO::writeBlocking(vector<FileJob>& jobs, const size_t& first, const size_t& last) {
+    int done = 0;
+    for (size_t i = first; i < last; i++) {
+        FileJob& job = jobs[i];
+        ofstream file(job.path, ios::binary | ios::trunc);
+        if (!file.is_open()) {
+            error_code ec;
+            filesystem::create_directories(filesystem::path(job.path).parent_path(), ec);
+            file.open(job.path, ios::binary | ios::trunc);
+        }
+        job.ok = file.is_open() && file.write(job.data.data(), (streamsize) job.data.size()) && file.flush();
+        done += job.ok;
+    }
+    return done;
+}
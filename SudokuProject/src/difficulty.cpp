@@ -0,0 +1,266 @@
+/**
+ * @file difficulty.cpp
+ * @brief Implementation of effort-based difficulty rating and bucketed generation.
+ *
+ * Detailed function descriptions are provided in the corresponding header file.
+ *
+ * @date
+ * October 19, 2026
+ */
+
+#include "../include/difficulty.h"
+#include "../include/generator.h"
+#include "../include/sudoku.h"
+#include "../include/sudoku_io.h"
+#include "../include/utils.h"
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <random>
+#include <thread>
+
+using namespace std;
+
+/**
+ * Board state for the rating solver: cell values plus a used-digit bitmask
+ * (bit d-1 set for digit d) per row, column and box.
+ */
+struct RatingGrid {
+    int cells[81];
+    int rows[9], cols[9], boxes[9];
+};
+
+static int candidates(const RatingGrid& grid, const int& cell)
+{
+    int r = cell / 9, c = cell % 9;
+    return ~(grid.rows[r] | grid.cols[c] | grid.boxes[3 * (r / 3) + c / 3]) & 0x1FF;
+}
+
+static void place(RatingGrid& grid, const int& cell, const int& bit)
+{
+    int r = cell / 9, c = cell % 9;
+    grid.cells[cell] = __builtin_ctz(bit) + 1;
+    grid.rows[r] |= bit;
+    grid.cols[c] |= bit;
+    grid.boxes[3 * (r / 3) + c / 3] |= bit;
+}
+
+/**
+ * Cell index of the i-th cell (0-8) of unit u: units 0-8 are rows, 9-17 columns, 18-26 boxes.
+ */
+static int unitCell(const int& u, const int& i)
+{
+    if (u < 9) return u * 9 + i;
+    if (u < 18) return i * 9 + (u - 9);
+    int b = u - 18;
+    return (3 * (b / 3) + i / 3) * 9 + 3 * (b % 3) + i % 3;
+}
+
+/**
+ * Fills forced cells until nothing changes. Hidden singles are only used when `hidden`
+ * is set and no naked single is left. Returns false on a contradiction.
+ */
+static bool propagate(RatingGrid& grid, const bool& hidden, SolveEffort& effort)
+{
+    bool changed = true;
+    while (changed) {
+        changed = false;
+        for (int cell = 0; cell < 81; cell++) {
+            if (grid.cells[cell] != 0) continue;
+            int mask = candidates(grid, cell);
+            if (mask == 0) return false;
+            if ((mask & (mask - 1)) == 0) {
+                place(grid, cell, mask);
+                effort.nakedSingles++;
+                changed = true;
+            }
+        }
+        if (changed || !hidden) continue;
+
+        for (int u = 0; u < 27; u++) {
+            // once: digits possible in exactly one cell so far, twice: in two or more
+            int once = 0, twice = 0, placed = 0;
+            for (int i = 0; i < 9; i++) {
+                int cell = unitCell(u, i);
+                if (grid.cells[cell] != 0) {
+                    placed |= 1 << (grid.cells[cell] - 1);
+                    continue;
+                }
+                int mask = candidates(grid, cell);
+                twice |= once & mask;
+                once |= mask;
+            }
+            if ((once | placed) != 0x1FF) return false;
+            int singles = once & ~twice;
+            for (int i = 0; i < 9 && singles != 0; i++) {
+                int cell = unitCell(u, i);
+                if (grid.cells[cell] != 0) continue;
+                int bit = candidates(grid, cell) & singles;
+                if (bit == 0) continue;
+                if (bit & (bit - 1)) return false; // two digits forced into one cell
+                place(grid, cell, bit);
+                singles ^= bit;
+                effort.hiddenSingles++;
+                changed = true;
+            }
+        }
+    }
+    return true;
+}
+
+static bool isComplete(const RatingGrid& grid)
+{
+    for (int cell = 0; cell < 81; cell++) {
+        if (grid.cells[cell] == 0) return false;
+    }
+    return true;
+}
+
+static bool search(RatingGrid grid, const int& depth, SolveEffort& effort)
+{
+    effort.nodes++;
+    effort.maxDepth = max(effort.maxDepth, depth);
+    if (!propagate(grid, true, effort)) return false;
+
+    int bestCell = -1, bestMask = 0, bestCount = 10;
+    for (int cell = 0; cell < 81; cell++) {
+        if (grid.cells[cell] != 0) continue;
+        int mask = candidates(grid, cell);
+        int options = __builtin_popcount(mask);
+        if (options < bestCount) {
+            bestCell = cell;
+            bestMask = mask;
+            bestCount = options;
+        }
+    }
+    if (bestCell == -1) return true;
+
+    effort.guesses++;
+    while (bestMask != 0) {
+        int bit = bestMask & -bestMask;
+        bestMask ^= bit;
+        RatingGrid child = grid;
+        place(child, bestCell, bit);
+        if (search(child, depth + 1, effort)) return true;
+    }
+    return false;
+}
+
+SolveEffort rateBoard(int** BOARD)
+{
+    SolveEffort effort;
+    RatingGrid grid {};
+    for (int cell = 0; cell < 81; cell++) {
+        int k = BOARD[cell / 9][cell % 9];
+        if (k == 0) continue;
+        int bit = 1 << (k - 1);
+        if (!(candidates(grid, cell) & bit)) return effort; // clues already conflict
+        place(grid, cell, bit);
+    }
+
+    // Naked singles only
+    RatingGrid easy = grid;
+    if (propagate(easy, false, effort) && isComplete(easy)) {
+        effort.nodes = 1;
+        effort.solved = true;
+        effort.difficulty = EASY;
+        return effort;
+    }
+
+    // Naked and hidden singles, then guessing if still needed
+    effort = SolveEffort();
+    effort.solved = search(grid, 0, effort);
+    if (effort.guesses == 0) effort.difficulty = MEDIUM;
+    else if (effort.guesses <= HARD_MAX_GUESSES) effort.difficulty = HARD;
+    else effort.difficulty = EXPERT;
+    return effort;
+}
+
+string difficultyName(const Difficulty& difficulty)
+{
+    switch (difficulty) {
+        case EASY: return "easy";
+        case MEDIUM: return "medium";
+        case HARD: return "hard";
+        case EXPERT: return "expert";
+    }
+    return "unknown";
+}
+
+/**
+ * Builds one rejection-sampling candidate: a minimal puzzle with a random number
+ * of its solution's clues put back, so the puzzle stays uniquely solvable.
+ */
+static int** generateCandidate(mt19937& g)
+{
+    int** BOARD = generateMinimalBoard(g() % 2 == 0);
+    int** SOLUTION = deepCopyBoard(BOARD);
+    solve(SOLUTION);
+
+    vector<int> empty;
+    for (int cell = 0; cell < 81; cell++) {
+        if (BOARD[cell / 9][cell % 9] == 0) empty.push_back(cell);
+    }
+    shuffle(empty.begin(), empty.end(), g);
+    int extra = uniform_int_distribution<>(0, min<int>(20, empty.size()))(g);
+    for (int i = 0; i < extra; i++) {
+        int r = empty[i] / 9, c = empty[i] % 9;
+        BOARD[r][c] = SOLUTION[r][c];
+    }
+
+    deallocateBoard(SOLUTION);
+    return BOARD;
+}
+
+vector<RatedPuzzle> generateRatedPuzzles(const vector<int>& targets, const int& num_threads, const long long& max_attempts)
+{
+    vector<vector<RatedPuzzle>> buckets(NUM_DIFFICULTIES);
+    int missing = 0;
+    for (int d = 0; d < NUM_DIFFICULTIES && d < (int) targets.size(); d++) {
+        missing += max(0, targets[d]);
+    }
+
+    int workers = num_threads > 0 ? num_threads : (int) thread::hardware_concurrency();
+    if (workers < 1) workers = 1;
+
+    mutex bucketMutex;
+    atomic<long long> attempts(0);
+    atomic<bool> done(missing == 0);
+
+    vector<thread> pool;
+    for (int w = 0; w < workers; w++) {
+        pool.emplace_back([&]() {
+            random_device rd;
+            mt19937 g(rd());
+            while (!done.load(memory_order_relaxed)) {
+                if (max_attempts > 0 && attempts++ >= max_attempts) {
+                    done = true;
+                    break;
+                }
+                int** BOARD = generateCandidate(g);
+                SolveEffort effort = rateBoard(BOARD);
+
+                bool kept = false;
+                {
+                    lock_guard<mutex> lock(bucketMutex);
+                    int d = effort.difficulty;
+                    if (!done && effort.solved && d < (int) targets.size() && (int) buckets[d].size() < targets[d]) {
+                        buckets[d].push_back({BOARD, effort});
+                        kept = true;
+                        if (--missing == 0) done = true;
+                    }
+                }
+                if (!kept) deallocateBoard(BOARD);
+            }
+        });
+    }
+    for (thread& worker : pool) {
+        worker.join();
+    }
+
+    vector<RatedPuzzle> puzzles;
+    for (auto& bucket : buckets) {
+        puzzles.insert(puzzles.end(), bucket.begin(), bucket.end());
+    }
+    return puzzles;
+}
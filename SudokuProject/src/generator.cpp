@@ -27,10 +27,15 @@
 #include "../include/generator.h"
 #include "../include/sudoku.h"
 #include "../include/sudoku_io.h"
+#include "../include/utils.h"
 #include <random>
+#include <algorithm>
 #include <bitset>
+#include <sstream>
 #include <cstdlib>  // for rand() and srand()
 #include <ctime>    // for time()
+#include <thread>
+#include <memory>
 
 
 using namespace std;
@@ -66,11 +71,28 @@ void fillBoardWithIndependentBox(int** BOARD) {
     }
 }
 
-void deleteRandomItems(int** BOARD, const int& n) {
+/**
+ * fillBoardWithIndependentBox() drawing from a caller-owned generator, without allocating.
+ */
+static void fillIndependentBoxesWith(int** BOARD, mt19937& g) {
+    int numbers[9] = {1, 2, 3, 4, 5, 6, 7, 8, 9};
+    for (int start = 0; start < 9; start += 3) {
+        shuffle(numbers, numbers + 9, g);
+        int pos = 0;
+        for (int row = start; row < start + 3; row++) {
+            for (int col = start; col < start + 3; col++, pos++) {
+                BOARD[row][col] = numbers[pos];
+            }
+        }
+    }
+}
+
+/**
+ * deleteRandomItems() drawing from a caller-owned generator.
+ */
+static void deleteRandomItemsWith(int** BOARD, const int& n, mt19937& g) {
     if (BOARD != nullptr && n > 0 && n < 82) {
         bitset<9> bitBoard[9];
-        random_device rd;
-        mt19937 g(rd());
         uniform_int_distribution<> dis(0, 8);
         for (int i = 0; i < n; i++) {
             int randRow = dis(g);
@@ -83,12 +105,279 @@ void deleteRandomItems(int** BOARD, const int& n) {
     }
 }
 
+void deleteRandomItems(int** BOARD, const int& n) {
+    random_device rd;
+    mt19937 g(rd());
+    deleteRandomItemsWith(BOARD, n, g);
+}
+
 int** generateBoard(const int& empty_boxes){
 
     int** BOARD = getEmptyBoard();
     fillBoardWithIndependentBox(BOARD);
-    solve(BOARD);
+    solve(BOARD, BASIC_SOLVER);
     deleteRandomItems(BOARD, empty_boxes);
 
     return BOARD;
-}
\ No newline at end of file
+}
+
+/**
+ * isRemovalUnique() working in a caller-owned TRIAL board instead of a fresh copy.
+ */
+static bool removalKeepsUnique(int** BOARD, int** SOLUTION, const int* cells, const int& count, int** TRIAL) {
+    copyBoard(BOARD, TRIAL);
+    for (int i = 0; i < count; i++) {
+        TRIAL[cells[i] / 9][cells[i] % 9] = 0;
+    }
+
+    for (int i = 0; i < count; i++) {
+        int r = cells[i] / 9, c = cells[i] % 9;
+        // Try every other digit in this cell; cells before it keep their solution value
+        for (int k = 1; k <= 9; k++) {
+            if (k == SOLUTION[r][c] || !isValid(TRIAL, r, c, k)) continue;
+            TRIAL[r][c] = k;
+            if (countSolutions(TRIAL, 1) > 0) return false;
+            TRIAL[r][c] = 0;
+        }
+        TRIAL[r][c] = SOLUTION[r][c];
+    }
+    return true;
+}
+
+bool isRemovalUnique(int** BOARD, int** SOLUTION, const std::vector<int>& cells) {
+    int** TRIAL = getEmptyBoard();
+    bool unique = removalKeepsUnique(BOARD, SOLUTION, cells.data(), (int) cells.size(), TRIAL);
+    deallocateBoard(TRIAL);
+    return unique;
+}
+
+RemovalCheckPool::RemovalCheckPool(const int& num_threads) {
+    int threads = max(1, num_threads);
+    for (int i = 0; i < threads; i++) trials_.push_back(getEmptyBoard());
+    for (int i = 1; i < threads; i++) workers_.emplace_back(&RemovalCheckPool::work, this, trials_[i]);
+}
+
+RemovalCheckPool::~RemovalCheckPool() {
+    {
+        lock_guard<mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    wake_.notify_all();
+    for (thread& worker : workers_) worker.join();
+    for (int** TRIAL : trials_) deallocateBoard(TRIAL);
+}
+
+int RemovalCheckPool::threads() const {
+    return (int) trials_.size();
+}
+
+void RemovalCheckPool::checkClaimed(int** TRIAL) {
+    for (int i = next_.fetch_add(1); i < count_; i = next_.fetch_add(1)) {
+        passed_[i] = removalKeepsUnique(board_, solution_, removals_[i].cells, removals_[i].count, TRIAL);
+    }
+}
+
+void RemovalCheckPool::work(int** TRIAL) {
+    long long seen = 0;
+    unique_lock<mutex> lock(mutex_);
+    for (;;) {
+        wake_.wait(lock, [&]() { return stopping_ || generation_ != seen; });
+        if (stopping_) return;
+        seen = generation_;
+        lock.unlock();
+        checkClaimed(TRIAL);
+        lock.lock();
+        if (--busy_ == 0) done_.notify_one();
+    }
+}
+
+void RemovalCheckPool::check(int** BOARD, int** SOLUTION, const ClueRemoval* removals, const int& count, char* passed) {
+    board_ = BOARD;
+    solution_ = SOLUTION;
+    removals_ = removals;
+    passed_ = passed;
+    count_ = count;
+    next_.store(0);
+    if (!workers_.empty() && count > 1) {
+        {
+            lock_guard<mutex> lock(mutex_);
+            busy_ = (int) workers_.size();
+            generation_++;
+        }
+        wake_.notify_all();
+        checkClaimed(trials_[0]);
+        unique_lock<mutex> lock(mutex_);
+        done_.wait(lock, [&]() { return busy_ == 0; });
+    } else {
+        checkClaimed(trials_[0]);
+    }
+}
+
+/**
+ * Clue removal used by generateMinimalBoard() and PuzzleStream. BOARD holds a solved
+ * board on entry and the minimal puzzle on return; SOLUTION is a scratch board.
+ *
+ * The pool tests as many candidates at once as it has threads. The first one that passes
+ * is removed, failed ones are discarded for good and passing ones after it are tested
+ * again against the smaller puzzle, so the result is the same for every thread count.
+ */
+static void minimizeBoard(int** BOARD, int** SOLUTION, RemovalCheckPool& pool, const bool& symmetric, mt19937& g) {
+    copyBoard(BOARD, SOLUTION);
+
+    // Removal candidates: every cell, or the first cell of each mirrored pair
+    int order[81];
+    int groups = 0;
+    for (int cell = 0; cell < 81; cell++) {
+        if (!symmetric || cell <= 40) order[groups++] = cell;
+    }
+    shuffle(order, order + groups, g);
+
+    ClueRemoval pending[81];
+    for (int i = 0; i < groups; i++) {
+        pending[i].cells[0] = order[i];
+        pending[i].cells[1] = 80 - order[i];
+        pending[i].count = (symmetric && order[i] != 40) ? 2 : 1;
+    }
+
+    char passed[81];
+    int next = 0;
+    while (next < groups) {
+        int count = min(pool.threads(), groups - next);
+        pool.check(BOARD, SOLUTION, pending + next, count, passed);
+
+        int accepted = 0;
+        while (accepted < count && !passed[accepted]) accepted++;
+        if (accepted == count) {
+            next += count;
+            continue;
+        }
+        const ClueRemoval& removal = pending[next + accepted];
+        for (int j = 0; j < removal.count; j++) {
+            BOARD[removal.cells[j] / 9][removal.cells[j] % 9] = 0;
+        }
+
+        // Move the passing candidates after it to the end of the tested range and resume there
+        ClueRemoval retest[81];
+        int retests = 0;
+        for (int i = accepted + 1; i < count; i++) {
+            if (passed[i]) retest[retests++] = pending[next + i];
+        }
+        next += count - retests;
+        for (int i = 0; i < retests; i++) pending[next + i] = retest[i];
+    }
+}
+
+int** generateMinimalBoard(const bool& symmetric, const int& num_threads) {
+    // One pool per calling thread, kept across batches and puzzles
+    thread_local unique_ptr<RemovalCheckPool> pool;
+    int threads = max(1, num_threads);
+    if (!pool || pool->threads() != threads) pool.reset(new RemovalCheckPool(threads));
+
+    random_device rd;
+    mt19937 g(rd());
+    int** BOARD = generateBoard(0);
+    int** SOLUTION = getEmptyBoard();
+    minimizeBoard(BOARD, SOLUTION, *pool, symmetric, g);
+    deallocateBoard(SOLUTION);
+    return BOARD;
+}
+
+void generateBoardOfSize(int* cells, const int& box_size, const int& empty_cells, mt19937& generator) {
+    const int n = box_size * box_size;
+    auto shuffledGroups = [&](const int& count) {
+        vector<int> order(count);
+        for (int i = 0; i < count; i++) order[i] = i;
+        shuffle(order.begin(), order.end(), generator);
+        return order;
+    };
+    // rows[i] / cols[i]: which pattern row / column ends up at position i
+    vector<int> digits = shuffledGroups(n), rows, cols;
+    for (int band : shuffledGroups(box_size)) {
+        for (int row : shuffledGroups(box_size)) rows.push_back(band * box_size + row);
+    }
+    for (int stack : shuffledGroups(box_size)) {
+        for (int col : shuffledGroups(box_size)) cols.push_back(stack * box_size + col);
+    }
+    for (int r = 0; r < n; r++) {
+        for (int c = 0; c < n; c++) {
+            int pr = rows[r], pc = cols[c];
+            cells[r * n + c] = digits[(box_size * (pr % box_size) + pr / box_size + pc) % n] + 1;
+        }
+    }
+
+    vector<int> order = shuffledGroups(n * n);
+    for (int i = 0; i < empty_cells && i < n * n; i++) cells[order[i]] = 0;
+}
+
+// ========================= PuzzleStream =========================
+
+PuzzleStream::PuzzleStream(const int& empty_boxes, const long long& count, const unsigned& seed, const PuzzleMode& mode,
+                           const int& num_threads)
+    : empty_boxes_(empty_boxes), count_(count), mode_(mode), generator_(seed) {
+    if (seed == 0) {
+        random_device rd;
+        generator_.seed(rd());
+    }
+    board_ = getEmptyBoard();
+    solution_ = getEmptyBoard();
+    pool_.reset(new RemovalCheckPool(mode == RANDOM_REMOVAL ? 1 : num_threads));
+}
+
+PuzzleStream::~PuzzleStream() {
+    deallocateBoard(board_);
+    deallocateBoard(solution_);
+}
+
+bool PuzzleStream::next() {
+    if (count_ != ENDLESS_PUZZLE_STREAM && produced_ >= count_) return false;
+
+    for (int r = 0; r < 9; r++) {
+        for (int c = 0; c < 9; c++) {
+            board_[r][c] = 0;
+        }
+    }
+    fillIndependentBoxesWith(board_, generator_);
+    solve(board_, BASIC_SOLVER);
+    if (mode_ == RANDOM_REMOVAL) deleteRandomItemsWith(board_, empty_boxes_, generator_);
+    else minimizeBoard(board_, solution_, *pool_, mode_ == SYMMETRIC_MINIMAL, generator_);
+
+    produced_++;
+    return true;
+}
+
+int** PuzzleStream::board() const {
+    return board_;
+}
+
+long long PuzzleStream::produced() const {
+    return produced_;
+}
+
+string PuzzleStream::saveState() const {
+    ostringstream state;
+    state << produced_ << " " << generator_;
+    return state.str();
+}
+
+bool PuzzleStream::restoreState(const string& state) {
+    istringstream input(state);
+    long long produced;
+    mt19937 generator;
+    if (!(input >> produced >> generator) || produced < 0) return false;
+    produced_ = produced;
+    generator_ = generator;
+    return true;
+}
+
+PuzzleStream::iterator PuzzleStream::begin() {
+    return iterator(next() ? this : nullptr);
+}
+
+PuzzleStream::iterator PuzzleStream::end() {
+    return iterator(nullptr);
+}
+
+PuzzleStream::iterator& PuzzleStream::iterator::operator++() {
+    if (stream_ != nullptr && !stream_->next()) stream_ = nullptr;
+    return *this;
+}
@@ -0,0 +1,162 @@
+/**
+ * @file journal.cpp
+ * @brief Implementation of the append-only progress journal.
+ *
+ * Detailed function descriptions are provided in the corresponding header file.
+ *
+ * @date
+ * October 19, 2026
+ */
+
+#include "../include/journal.h"
+#include <algorithm>
+#include <filesystem>
+#include <iostream>
+#include <sstream>
+
+using namespace std;
+
+ProgressJournal::ProgressJournal(const string& filename, const string& run_key, const int& batch_size)
+    : filename_(filename), batch_size_(batch_size > 0 ? batch_size : 1) {
+    load(run_key);
+    if (resumed_) {
+        file_.open(filename_, ios::app);
+    } else {
+        file_.open(filename_, ios::trunc);
+        file_ << "run " << run_key << "\n";
+        file_.flush();
+    }
+    if (!file_.is_open()) cerr << "Unable to open journal: " << filename_ << endl;
+}
+
+ProgressJournal::~ProgressJournal() {
+    flush();
+}
+
+void ProgressJournal::load(const string& run_key) {
+    ifstream input(filename_, ios::binary);
+    if (!input.is_open()) return;
+
+    string line;
+    streamoff complete = 0;  // Bytes up to the end of the last complete record
+    bool matches = false;
+    while (getline(input, line)) {
+        if (input.eof()) break;  // Last record has no newline: cut short by a crash
+        complete = input.tellg();
+        if (!matches) {
+            matches = line == "run " + run_key;
+            if (!matches) return;
+            continue;
+        }
+
+        istringstream record(line);
+        string type;
+        record >> type;
+        if (type == "state") {
+            record >> output_offset_;
+            record.get();
+            getline(record, generator_state_);
+            completed_on_start_ = output_offset_;
+        } else if (type == "done") {
+            long long offset = 0;
+            record >> offset;
+            output_offset_ = max(output_offset_, offset);
+            int index;
+            while (record >> index) {
+                if (done_indices_.insert(index).second) completed_on_start_++;
+            }
+        } else if (type == "file") {
+            long long offset = 0;
+            string path;
+            record >> offset;
+            output_offset_ = max(output_offset_, offset);
+            record.get();
+            getline(record, path);
+            if (done_paths_.insert(path).second) completed_on_start_++;
+        }
+    }
+    if (!matches) return;
+
+    input.close();
+    error_code ec;
+    if ((streamoff) filesystem::file_size(filename_, ec) > complete) filesystem::resize_file(filename_, complete, ec);
+    resumed_ = true;
+}
+
+bool ProgressJournal::resumed() const {
+    return resumed_;
+}
+
+long long ProgressJournal::completedOnStart() const {
+    return completed_on_start_;
+}
+
+long long ProgressJournal::outputOffset() const {
+    return output_offset_;
+}
+
+const string& ProgressJournal::generatorState() const {
+    return generator_state_;
+}
+
+bool ProgressJournal::isDone(const int& index) const {
+    return done_indices_.count(index) > 0;
+}
+
+bool ProgressJournal::isDone(const string& path) const {
+    return done_paths_.count(path) > 0;
+}
+
+void ProgressJournal::markDone(const int& index, const long long& output_offset) {
+    lock_guard<mutex> lock(mutex_);
+    pending_indices_.push_back(index);
+    pending_offset_ = max(pending_offset_, output_offset);
+    if ((int) (pending_indices_.size() + pending_paths_.size()) >= batch_size_) flushLocked();
+}
+
+void ProgressJournal::markDone(const string& path, const long long& output_offset) {
+    lock_guard<mutex> lock(mutex_);
+    pending_paths_.push_back(make_pair(path, output_offset));
+    pending_offset_ = max(pending_offset_, output_offset);
+    if ((int) (pending_indices_.size() + pending_paths_.size()) >= batch_size_) flushLocked();
+}
+
+void ProgressJournal::checkpoint(const long long& output_offset, const string& generator_state) {
+    lock_guard<mutex> lock(mutex_);
+    flushLocked();
+    appendLocked("state " + to_string(output_offset) + " " + generator_state + "\n");
+}
+
+void ProgressJournal::flush() {
+    lock_guard<mutex> lock(mutex_);
+    flushLocked();
+}
+
+void ProgressJournal::flushLocked() {
+    if (pending_indices_.empty() && pending_paths_.empty()) return;
+    ostringstream records;
+    if (!pending_indices_.empty()) {
+        records << "done " << pending_offset_;
+        for (int index : pending_indices_) records << " " << index;
+        records << "\n";
+    }
+    for (const auto& path : pending_paths_) records << "file " << path.second << " " << path.first << "\n";
+    pending_indices_.clear();
+    pending_paths_.clear();
+    appendLocked(records.str());
+}
+
+void ProgressJournal::appendLocked(const string& record) {
+    // One write per batch; a crash mid-write leaves a partial last line that load() drops
+    file_ << record;
+    file_.flush();
+}
+
+void ProgressJournal::finish() {
+    lock_guard<mutex> lock(mutex_);
+    pending_indices_.clear();
+    pending_paths_.clear();
+    file_.close();
+    error_code ec;
+    filesystem::remove(filename_, ec);
+}
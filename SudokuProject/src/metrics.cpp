@@ -0,0 +1,299 @@
+/**
+ * @file metrics.cpp
+ * @brief Implementation of latency histograms, metric series and status reporting.
+ *
+ * Detailed function descriptions are provided in the corresponding header file.
+ *
+ * @date
+ * October 19, 2026
+ */
+
+#include "../include/metrics.h"
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <regex>
+#include <sstream>
+
+using namespace std;
+using namespace std::chrono;
+
+// ========================= LatencyHistogram =========================
+
+LatencyHistogram::LatencyHistogram() : buckets_(new atomic<long long>[BUCKETS]) {
+    for (int i = 0; i < BUCKETS; i++) {
+        buckets_[i].store(0, memory_order_relaxed);
+    }
+}
+
+int LatencyHistogram::bucketIndex(unsigned long long value) {
+    if (value < 2 * SUB_BUCKETS) return (int) value;
+    int shift = 63 - __builtin_clzll(value) - SUB_BUCKET_BITS;
+    return (shift + 1) * SUB_BUCKETS + (int) ((value >> shift) - SUB_BUCKETS);
+}
+
+unsigned long long LatencyHistogram::bucketLow(const int& index) {
+    if (index < 2 * SUB_BUCKETS) return index;
+    int shift = index / SUB_BUCKETS - 1;
+    return (unsigned long long) (index % SUB_BUCKETS + SUB_BUCKETS) << shift;
+}
+
+void LatencyHistogram::record(long long nanoseconds) {
+    if (nanoseconds < 0) nanoseconds = 0;
+    buckets_[bucketIndex(nanoseconds)].fetch_add(1, memory_order_relaxed);
+    count_.fetch_add(1, memory_order_relaxed);
+    sum_.fetch_add(nanoseconds, memory_order_relaxed);
+    long long seen = max_.load(memory_order_relaxed);
+    while (nanoseconds > seen && !max_.compare_exchange_weak(seen, nanoseconds, memory_order_relaxed)) {}
+}
+
+long long LatencyHistogram::count() const {
+    return count_.load(memory_order_relaxed);
+}
+
+long long LatencyHistogram::max() const {
+    return max_.load(memory_order_relaxed);
+}
+
+double LatencyHistogram::mean() const {
+    long long n = count();
+    return n == 0 ? 0.0 : (double) sum_.load(memory_order_relaxed) / n;
+}
+
+long long LatencyHistogram::percentile(const double& quantile) const {
+    long long n = count();
+    if (n == 0) return 0;
+    long long rank = (long long) (quantile * n);
+    if (rank >= n) rank = n - 1;
+    long long seen = 0;
+    for (int i = 0; i < BUCKETS; i++) {
+        seen += buckets_[i].load(memory_order_relaxed);
+        if (seen > rank) {
+            unsigned long long low = bucketLow(i);
+            unsigned long long high = i + 1 < BUCKETS ? bucketLow(i + 1) : low;
+            long long middle = (long long) (low + (high - low) / 2);
+            return middle < max() ? middle : max();
+        }
+    }
+    return max();
+}
+
+long long LatencyHistogram::sum() const {
+    return sum_.load(memory_order_relaxed);
+}
+
+vector<pair<int, long long>> LatencyHistogram::buckets() const {
+    vector<pair<int, long long>> result;
+    for (int i = 0; i < BUCKETS; i++) {
+        long long samples = buckets_[i].load(memory_order_relaxed);
+        if (samples > 0) result.emplace_back(i, samples);
+    }
+    return result;
+}
+
+void LatencyHistogram::addSamples(const vector<pair<int, long long>>& buckets, const long long& sum, const long long& max) {
+    for (const auto& [index, samples] : buckets) {
+        if (index < 0 || index >= BUCKETS) continue;
+        buckets_[index].fetch_add(samples, memory_order_relaxed);
+        count_.fetch_add(samples, memory_order_relaxed);
+    }
+    sum_.fetch_add(sum, memory_order_relaxed);
+    long long seen = max_.load(memory_order_relaxed);
+    while (max > seen && !max_.compare_exchange_weak(seen, max, memory_order_relaxed)) {}
+}
+
+// ========================= MetricSeries =========================
+
+void MetricSeries::record(long long nanoseconds, const bool& ok) {
+    count.fetch_add(1, memory_order_relaxed);
+    if (!ok) failures.fetch_add(1, memory_order_relaxed);
+    latency.record(nanoseconds);
+}
+
+void MetricSeries::recordPerf(const PerfSample& sample) {
+    for (int e = 0; e < NUM_PERF_EVENTS; e++) {
+        if (!sample.has((PerfEvent) e)) continue;
+        perfTotals[e].fetch_add(sample.values[e], memory_order_relaxed);
+        perfSamples[e].fetch_add(1, memory_order_relaxed);
+    }
+}
+
+double MetricSeries::perfMean(const PerfEvent& event) const {
+    long long samples = perfSamples[event].load(memory_order_relaxed);
+    return samples == 0 ? -1.0 : (double) perfTotals[event].load(memory_order_relaxed) / samples;
+}
+
+// ========================= Metrics =========================
+
+Metrics::Metrics(const string& run_name) : name_(run_name), start_(steady_clock::now()) {}
+
+MetricSeries& Metrics::series(const string& name) {
+    lock_guard<mutex> lock(mutex_);
+    for (auto& existing : series_) {
+        if (existing->name == name) return *existing;
+    }
+    series_.emplace_back(new MetricSeries());
+    series_.back()->name = name;
+    return *series_.back();
+}
+
+double Metrics::elapsedSeconds() const {
+    if (mergedElapsed_ > 0) return mergedElapsed_;
+    return duration<double>(steady_clock::now() - start_).count();
+}
+
+string Metrics::toJson() const {
+    lock_guard<mutex> lock(mutex_);
+    double elapsed = elapsedSeconds();
+    ostringstream json;
+    json << fixed << setprecision(3);
+    json << "{\n  \"run\": \"" << name_ << "\",\n  \"elapsed_seconds\": " << elapsed << ",\n  \"series\": [";
+    for (size_t i = 0; i < series_.size(); i++) {
+        const MetricSeries& s = *series_[i];
+        long long count = s.count.load(memory_order_relaxed);
+        json << (i == 0 ? "\n" : ",\n")
+             << "    {\"name\": \"" << s.name << "\", \"count\": " << count
+             << ", \"failures\": " << s.failures.load(memory_order_relaxed)
+             << ", \"per_second\": " << (elapsed > 0 ? count / elapsed : 0.0);
+        bool anyPerf = false;
+        for (int e = 0; e < NUM_PERF_EVENTS; e++) {
+            long long samples = s.perfSamples[e].load(memory_order_relaxed);
+            if (samples == 0) continue;
+            json << (anyPerf ? ", " : ", \"perf\": {") << "\"" << perfEventName((PerfEvent) e) << "\": ["
+                 << s.perfTotals[e].load(memory_order_relaxed) << ", " << samples << "]";
+            anyPerf = true;
+        }
+        if (anyPerf) json << "}";
+        json
+             << ", \"latency_ns\": {\"mean\": " << s.latency.mean()
+             << ", \"p50\": " << s.latency.percentile(0.5)
+             << ", \"p99\": " << s.latency.percentile(0.99)
+             << ", \"p999\": " << s.latency.percentile(0.999)
+             << ", \"max\": " << s.latency.max() << "}"
+             << ", \"sum_ns\": " << s.latency.sum() << ", \"buckets\": [";
+        vector<pair<int, long long>> buckets = s.latency.buckets();
+        for (size_t b = 0; b < buckets.size(); b++) {
+            json << (b == 0 ? "" : ", ") << "[" << buckets[b].first << ", " << buckets[b].second << "]";
+        }
+        json << "]}";
+    }
+    json << "\n  ]\n}\n";
+    return json.str();
+}
+
+bool Metrics::writeJson(const string& filename) const {
+    ofstream outFile(filename);
+    if (outFile.is_open()) {
+        outFile << toJson();
+        outFile.close();
+        return true;
+    }
+    cerr << "Unable to open file: " << filename << endl;
+    return false;
+}
+
+bool Metrics::mergeJson(const string& filename) {
+    ifstream inFile(filename);
+    if (!inFile.is_open()) {
+        cerr << "Unable to open file: " << filename << endl;
+        return false;
+    }
+
+    // writeJson() puts the run header and every series on a line of their own
+    static const regex elapsedPattern("\"elapsed_seconds\": ([0-9.]+)");
+    static const regex seriesPattern("\"name\": \"([^\"]*)\", \"count\": (\\d+), \"failures\": (\\d+).*"
+                                     "\"max\": (\\d+)\\}, \"sum_ns\": (\\d+), \"buckets\": \\[(.*)\\]\\}");
+    static const regex bucketPattern("\\[(\\d+), (\\d+)\\]");
+    static const regex perfPattern("\"perf\": \\{([^}]*)\\}");
+    static const regex perfEventPattern("\"(\\w+)\": \\[(\\d+), (\\d+)\\]");
+    bool sawHeader = false;
+    string line;
+    smatch match;
+    while (getline(inFile, line)) {
+        if (regex_search(line, match, elapsedPattern)) {
+            mergedElapsed_ = std::max(mergedElapsed_, stod(match[1]));
+            sawHeader = true;
+        } else if (regex_search(line, match, seriesPattern)) {
+            MetricSeries& merged = series(match[1]);
+            merged.count.fetch_add(stoll(match[2]), memory_order_relaxed);
+            merged.failures.fetch_add(stoll(match[3]), memory_order_relaxed);
+
+            vector<pair<int, long long>> buckets;
+            string bucketList = match[6];
+            for (sregex_iterator it(bucketList.begin(), bucketList.end(), bucketPattern), end; it != end; ++it) {
+                buckets.emplace_back(stoi((*it)[1]), stoll((*it)[2]));
+            }
+            merged.latency.addSamples(buckets, stoll(match[5]), stoll(match[4]));
+
+            smatch perf;
+            if (!regex_search(line, perf, perfPattern)) continue;
+            string perfList = perf[1];
+            for (sregex_iterator it(perfList.begin(), perfList.end(), perfEventPattern), end; it != end; ++it) {
+                for (int e = 0; e < NUM_PERF_EVENTS; e++) {
+                    if ((*it)[1] != perfEventName((PerfEvent) e)) continue;
+                    merged.perfTotals[e].fetch_add(stoll((*it)[2]), memory_order_relaxed);
+                    merged.perfSamples[e].fetch_add(stoll((*it)[3]), memory_order_relaxed);
+                }
+            }
+        }
+    }
+    if (!sawHeader) cerr << "Not a metrics report: " << filename << endl;
+    return sawHeader;
+}
+
+void Metrics::printSummary() const {
+    lock_guard<mutex> lock(mutex_);
+    double elapsed = elapsedSeconds();
+    cout << "====================== Metrics (" << name_ << ") ======================" << endl;
+    cout << setw(12) << "Series" << setw(9) << "Count" << setw(8) << "Failed" << setw(12) << "Items/sec"
+         << setw(11) << "Mean(ms)" << setw(10) << "p50(ms)" << setw(10) << "p99(ms)" << setw(11) << "p999(ms)" << endl;
+    cout << setfill('-') << setw(83) << "" << setfill(' ') << endl;
+    for (const auto& s : series_) {
+        long long count = s->count.load(memory_order_relaxed);
+        cout << setw(12) << s->name << setw(9) << count << setw(8) << s->failures.load(memory_order_relaxed)
+             << fixed << setprecision(1) << setw(12) << (elapsed > 0 ? count / elapsed : 0.0)
+             << setprecision(4) << setw(11) << s->latency.mean() / 1e6
+             << setw(10) << s->latency.percentile(0.5) / 1e6
+             << setw(10) << s->latency.percentile(0.99) / 1e6
+             << setw(11) << s->latency.percentile(0.999) / 1e6 << endl;
+    }
+    cout << "===========================================================================" << endl;
+}
+
+// ========================= StatusReporter =========================
+
+StatusReporter::StatusReporter(const Metrics& metrics, MetricSeries& progress, const long long& total, const int& interval_ms)
+    : metrics_(metrics), progress_(progress), total_(total), interval_(interval_ms) {
+    thread_ = thread([this]() {
+        unique_lock<mutex> lock(mutex_);
+        while (!wake_.wait_for(lock, interval_, [this]() { return stopped_; })) {
+            printStatus();
+        }
+    });
+}
+
+StatusReporter::~StatusReporter() {
+    stop();
+}
+
+void StatusReporter::stop() {
+    {
+        lock_guard<mutex> lock(mutex_);
+        if (stopped_) return;
+        stopped_ = true;
+    }
+    wake_.notify_all();
+    thread_.join();
+    printStatus();
+    cout << endl;
+}
+
+void StatusReporter::printStatus() const {
+    double elapsed = metrics_.elapsedSeconds();
+    long long done = progress_.count.load(memory_order_relaxed);
+    cout << "\r[" << fixed << setprecision(1) << setw(7) << elapsed << "s] " << progress_.name << " "
+         << done << "/" << total_ << " (" << (elapsed > 0 ? done / elapsed : 0.0) << "/s, p99 "
+         << setprecision(3) << progress_.latency.percentile(0.99) / 1e6 << " ms, failed "
+         << progress_.failures.load(memory_order_relaxed) << ")   ";
+    cout.flush();
+}
@@ -0,0 +1,133 @@
+/**
+ * @file perf_counters.cpp
+ * @brief Implementation of the perf_event_open counter group.
+ *
+ * Detailed function descriptions are provided in the corresponding header file.
+ *
+ * @date
+ * October 19, 2026
+ */
+
+#include "../include/perf_counters.h"
+
+#if defined(__linux__) && __has_include(<linux/perf_event.h>)
+#define SUDOKU_HAVE_PERF_EVENTS 1
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <cerrno>
+#include <cstring>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+const char* perfEventName(const PerfEvent& event) {
+    switch (event) {
+        case PERF_CYCLES: return "cycles";
+        case PERF_INSTRUCTIONS: return "instructions";
+        case PERF_BRANCH_MISSES: return "branch_misses";
+        case PERF_L1D_MISSES: return "l1d_misses";
+        case PERF_LLC_MISSES: return "llc_misses";
+    }
+    return "unknown";
+}
+
+#ifdef SUDOKU_HAVE_PERF_EVENTS
+
+/**
+ * Opens one counter of the calling thread, user space only, as part of `group`
+ * (or as a new group leader if `group` is -1). Returns the descriptor or -1.
+ */
+static int openEvent(const PerfEvent& event, const int& group)
+{
+    perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = PERF_TYPE_HARDWARE;
+    switch (event) {
+        case PERF_CYCLES: attr.config = PERF_COUNT_HW_CPU_CYCLES; break;
+        case PERF_INSTRUCTIONS: attr.config = PERF_COUNT_HW_INSTRUCTIONS; break;
+        case PERF_BRANCH_MISSES: attr.config = PERF_COUNT_HW_BRANCH_MISSES; break;
+        case PERF_L1D_MISSES:
+            attr.type = PERF_TYPE_HW_CACHE;
+            attr.config = PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+            break;
+        case PERF_LLC_MISSES: attr.config = PERF_COUNT_HW_CACHE_MISSES; break;
+    }
+    attr.disabled = group == -1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+    return (int) syscall(__NR_perf_event_open, &attr, 0, -1, group, 0);
+}
+
+PerfCounters::PerfCounters() {
+    for (int e = 0; e < NUM_PERF_EVENTS; e++) fds_[e] = -1;
+    for (int e = 0; e < NUM_PERF_EVENTS; e++) {
+        int fd = openEvent((PerfEvent) e, leader_);
+        if (fd < 0) {
+            if (reason_.empty()) reason_ = string("perf_event_open: ") + strerror(errno);
+            continue;
+        }
+        if (leader_ == -1) leader_ = fd;
+        fds_[e] = fd;
+        order_[open_count_++] = e;
+    }
+    if (open_count_ > 0) reason_.clear();
+}
+
+PerfCounters::~PerfCounters() {
+    for (int e = 0; e < NUM_PERF_EVENTS; e++) {
+        if (fds_[e] >= 0) close(fds_[e]);
+    }
+}
+
+void PerfCounters::start() {
+    if (leader_ < 0) return;
+    ioctl(leader_, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+    ioctl(leader_, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+}
+
+bool PerfCounters::stop(PerfSample& sample) {
+    sample = PerfSample();
+    if (leader_ < 0) return false;
+    ioctl(leader_, PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+
+    // Group layout: number of events, time enabled, time running, then one value per event
+    unsigned long long data[3 + NUM_PERF_EVENTS];
+    ssize_t size = read(leader_, data, sizeof(data));
+    if (size < (ssize_t) (3 * sizeof(unsigned long long)) || data[2] == 0) return false;
+    double scale = (double) data[1] / (double) data[2];
+    for (unsigned long long i = 0; i < data[0] && i < (unsigned long long) open_count_; i++) {
+        int event = order_[i];
+        sample.values[event] = (long long) (data[3 + i] * scale);
+        sample.measured |= 1 << event;
+    }
+    return sample.measured != 0;
+}
+
+#else
+
+PerfCounters::PerfCounters() : reason_("hardware counters need Linux perf events") {
+    for (int e = 0; e < NUM_PERF_EVENTS; e++) fds_[e] = -1;
+}
+
+PerfCounters::~PerfCounters() {}
+
+void PerfCounters::start() {}
+
+bool PerfCounters::stop(PerfSample& sample) {
+    sample = PerfSample();
+    return false;
+}
+
+#endif
+
+bool PerfCounters::available() const {
+    return open_count_ > 0;
+}
+
+const string& PerfCounters::unavailableReason() const {
+    return reason_;
+}
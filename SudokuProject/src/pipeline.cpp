@@ -0,0 +1,209 @@
+/**
+ * @file pipeline.cpp
+ * @brief Implementation of the in-memory generate -> solve -> validate pipeline.
+ *
+ * Detailed function descriptions are provided in the corresponding header file.
+ *
+ * @date
+ * October 19, 2026
+ */
+
+#include "../include/pipeline.h"
+#include "../include/bounded_queue.h"
+#include "../include/generator.h"
+#include "../include/sudoku.h"
+#include "../include/sudoku_io.h"
+#include "../include/utils.h"
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <thread>
+
+using namespace std;
+using namespace std::chrono;
+
+/**
+ * A board travelling through the pipeline.
+ */
+struct PipelineItem {
+    int index;
+    int** puzzle;
+    int** solution;
+    bool valid;
+};
+
+typedef BoundedQueue<PipelineItem*> ItemQueue;
+
+static void releaseItem(PipelineItem* item)
+{
+    deallocateBoard(item->puzzle);
+    deallocateBoard(item->solution);
+    delete item;
+}
+
+/**
+ * Runs one stage on `workers` threads. Each worker pops from `input` (or, for the first
+ * stage, calls `work` with nullptr until it returns nullptr), and pushes results to
+ * `output`. The last worker to finish closes `output`. `work` returns the item to pass
+ * on, or nullptr when the item was consumed. Busy and wait times are added to `metrics`.
+ */
+static vector<thread> startStage(StageMetrics& metrics, mutex& metricsMutex, ItemQueue* input, ItemQueue* output,
+                                 const function<PipelineItem*(PipelineItem*)>& work, atomic<int>& running)
+{
+    vector<thread> threads;
+    running = metrics.workers;
+    for (int w = 0; w < metrics.workers; w++) {
+        threads.emplace_back([&, input, output, work]() {
+            long long items = 0;
+            nanoseconds busy(0), wait(0);
+            for (;;) {
+                PipelineItem* item = nullptr;
+                auto waitStart = steady_clock::now();
+                if (input != nullptr && !input->pop(item)) break;
+                auto workStart = steady_clock::now();
+                PipelineItem* result = work(item);
+                auto workEnd = steady_clock::now();
+                wait += workStart - waitStart;
+                busy += workEnd - workStart;
+                if (input == nullptr && result == nullptr) break;
+                items++;
+                if (result != nullptr) {
+                    if (output != nullptr) {
+                        output->push(result);
+                        wait += steady_clock::now() - workEnd;
+                    } else {
+                        releaseItem(result);
+                    }
+                }
+            }
+            {
+                lock_guard<mutex> lock(metricsMutex);
+                metrics.items += items;
+                metrics.busy_seconds += duration<double>(busy).count();
+                metrics.wait_seconds += duration<double>(wait).count();
+            }
+            if (--running == 0 && output != nullptr) output->close();
+        });
+    }
+    return threads;
+}
+
+PipelineReport runPipeline(const PipelineConfig& config)
+{
+    PipelineReport report;
+    size_t capacity = config.queue_capacity > 0 ? config.queue_capacity : 1;
+    ItemQueue generated(capacity), solved(capacity), validated(capacity);
+
+    report.stages.resize(config.persist ? 4 : 3);
+    StageMetrics& generateStage = report.stages[0];
+    StageMetrics& solveStage = report.stages[1];
+    StageMetrics& validateStage = report.stages[2];
+    generateStage.name = "generate";
+    generateStage.workers = max(1, config.generator_workers);
+    solveStage.name = "solve";
+    solveStage.workers = max(1, config.solver_workers);
+    validateStage.name = "validate";
+    validateStage.workers = max(1, config.validator_workers);
+    if (config.persist) {
+        report.stages[3].name = "persist";
+        report.stages[3].workers = max(1, config.writer_workers);
+    }
+
+    mutex metricsMutex;
+    atomic<int> nextIndex(0);
+    atomic<long long> solveFailures(0), invalid(0), writeFailures(0), validSolutions(0);
+    atomic<int> running[4];
+
+    auto generate = [&](PipelineItem*) -> PipelineItem* {
+        int index = nextIndex++;
+        if (index >= config.num_puzzles) return nullptr;
+        int** puzzle = generateBoard(config.empty_boxes);
+        return new PipelineItem {index, puzzle, deepCopyBoard(puzzle), false};
+    };
+    auto solveItem = [&](PipelineItem* item) -> PipelineItem* {
+        if (!solve(item->solution)) solveFailures++;
+        return item;
+    };
+    auto validate = [&](PipelineItem* item) -> PipelineItem* {
+        item->valid = checkIfSolutionIsValid(item->solution);
+        if (item->valid) validSolutions++;
+        else invalid++;
+        return item;
+    };
+    auto persist = [&](PipelineItem* item) -> PipelineItem* {
+        string puzzleFile = getShardedFileName(item->index, config.puzzle_destination, config.puzzle_prefix);
+        if (!writeSudokuToFile(item->puzzle, puzzleFile)) writeFailures++;
+        if (item->valid) {
+            string solutionFile = getShardedFileName(item->index, config.solution_destination, config.solution_prefix);
+            if (!writeSudokuToFile(item->solution, solutionFile)) writeFailures++;
+        }
+        return item;
+    };
+
+    auto start = steady_clock::now();
+    vector<thread> threads;
+    auto launch = [&](StageMetrics& metrics, ItemQueue* input, ItemQueue* output,
+                      const function<PipelineItem*(PipelineItem*)>& work, atomic<int>& live) {
+        vector<thread> stage = startStage(metrics, metricsMutex, input, output, work, live);
+        for (thread& t : stage) threads.push_back(move(t));
+    };
+    launch(generateStage, nullptr, &generated, generate, running[0]);
+    launch(solveStage, &generated, &solved, solveItem, running[1]);
+    launch(validateStage, &solved, config.persist ? &validated : nullptr, validate, running[2]);
+    if (config.persist) launch(report.stages[3], &validated, nullptr, persist, running[3]);
+    for (thread& t : threads) t.join();
+    report.wall_seconds = duration<double>(steady_clock::now() - start).count();
+
+    ItemQueue* inputs[4] = {nullptr, &generated, &solved, &validated};
+    for (size_t s = 1; s < report.stages.size(); s++) {
+        report.stages[s].queue_average_depth = inputs[s]->averageDepth();
+        report.stages[s].queue_max_depth = inputs[s]->maxDepth();
+        report.stages[s].queue_capacity = inputs[s]->capacity();
+    }
+    solveStage.failures = solveFailures;
+    validateStage.failures = invalid;
+    if (config.persist) report.stages[3].failures = writeFailures;
+    report.valid_solutions = validSolutions;
+    return report;
+}
+
+void printPipelineReport(const PipelineReport& report)
+{
+    size_t bottleneck = 0;
+    double highest = -1.0;
+    for (size_t s = 0; s < report.stages.size(); s++) {
+        const StageMetrics& stage = report.stages[s];
+        double utilization = stage.busy_seconds / (stage.workers * max(report.wall_seconds, 1e-9));
+        if (utilization > highest) {
+            highest = utilization;
+            bottleneck = s;
+        }
+    }
+
+    cout << "====================== Pipeline Summary ======================" << endl;
+    cout << "Wall time: " << fixed << setprecision(4) << report.wall_seconds << " seconds | "
+         << "Valid solutions: " << report.valid_solutions << endl;
+    cout << setw(10) << "Stage" << setw(9) << "Workers" << setw(9) << "Items" << setw(12) << "Items/sec"
+         << setw(8) << "Util%" << setw(9) << "Wait(s)" << setw(10) << "QueueAvg" << setw(10) << "QueueMax"
+         << setw(9) << "Failed" << endl;
+    cout << setfill('-') << setw(86) << "" << setfill(' ') << endl;
+    for (size_t s = 0; s < report.stages.size(); s++) {
+        const StageMetrics& stage = report.stages[s];
+        double utilization = stage.busy_seconds / (stage.workers * max(report.wall_seconds, 1e-9));
+        cout << setw(10) << stage.name << setw(9) << stage.workers << setw(9) << stage.items
+             << setw(12) << setprecision(1) << stage.items / max(report.wall_seconds, 1e-9)
+             << setw(8) << setprecision(1) << 100 * utilization
+             << setw(9) << setprecision(3) << stage.wait_seconds;
+        if (stage.queue_capacity > 0) {
+            cout << setw(10) << setprecision(1) << stage.queue_average_depth
+                 << setw(10) << (to_string(stage.queue_max_depth) + "/" + to_string(stage.queue_capacity));
+        } else {
+            cout << setw(10) << "-" << setw(10) << "-";
+        }
+        cout << setw(9) << stage.failures << (s == bottleneck ? "  <- bottleneck" : "") << endl;
+    }
+    cout << "==============================================================" << endl;
+}
@@ -0,0 +1,549 @@
+/**
+ * @file sat_solver.cpp
+ * @brief Implementation of the CDCL SAT solver and the Sudoku encoding.
+ *
+ * Detailed function descriptions are provided in the corresponding header file.
+ *
+ * @date
+ * October 19, 2026
+ */
+
+#include "../include/sat_solver.h"
+#include <algorithm>
+
+using namespace std;
+
+// Conflicts in the first restart interval; interval i lasts RESTART_UNIT * luby(i) conflicts
+static const long long RESTART_UNIT = 100;
+static const double ACTIVITY_DECAY = 0.95;
+
+/**
+ * Element `i` (from 0) of the Luby sequence 1, 1, 2, 1, 1, 2, 4, ...
+ */
+static long long lubyTerm(long long i)
+{
+    long long size = 1, exponent = 0;
+    while (size < i + 1) {
+        size = 2 * size + 1;
+        exponent++;
+    }
+    while (size - 1 != i) {
+        size = (size - 1) / 2;
+        exponent--;
+        i %= size;
+    }
+    return 1LL << exponent;
+}
+
+// ========================= SatSolver =========================
+
+SatSolver::SatSolver() {}
+
+void SatSolver::reserve(const int& vars, const long long& clauses, const long long& literals) {
+    arena_.reserve(clauses + literals);
+    watches_.reserve(2 * (size_t) vars);
+    assigns_.reserve(vars);
+    phase_.reserve(vars);
+    level_.reserve(vars);
+    reason_.reserve(vars);
+    trail_.reserve(vars);
+    activity_.reserve(vars);
+    heap_.reserve(vars);
+    heap_position_.reserve(vars);
+    seen_.reserve(vars);
+}
+
+int SatSolver::newVar() {
+    int var = (int) assigns_.size();
+    watches_.emplace_back();
+    watches_.emplace_back();
+    assigns_.push_back(UNASSIGNED);
+    // Try "true" first: on Sudoku that places a digit, which propagates much further than ruling one out
+    phase_.push_back(1);
+    level_.push_back(0);
+    reason_.push_back(NO_REASON);
+    activity_.push_back(0.0);
+    heap_position_.push_back(-1);
+    seen_.push_back(0);
+    heapInsert(var);
+    return var;
+}
+
+int SatSolver::numVars() const {
+    return (int) assigns_.size();
+}
+
+int8_t SatSolver::valueOf(const int& lit) const {
+    int8_t value = assigns_[lit >> 1];
+    return value == UNASSIGNED ? UNASSIGNED : (int8_t) (value ^ (lit & 1));
+}
+
+int SatSolver::decisionLevel() const {
+    return (int) trail_limits_.size();
+}
+
+void SatSolver::assign(const int& lit, const int& reason) {
+    int var = lit >> 1;
+    assigns_[var] = (int8_t) !(lit & 1);
+    level_[var] = decisionLevel();
+    reason_[var] = reason;
+    trail_.push_back(lit);
+}
+
+void SatSolver::watchClause(const int& clause) {
+    const int* lits = &arena_[clause + 1];
+    watches_[lits[0] ^ 1].push_back({clause, lits[1]});
+    watches_[lits[1] ^ 1].push_back({clause, lits[0]});
+}
+
+bool SatSolver::addClause(const vector<int>& literals) {
+    if (unsatisfiable_) return false;
+    cancelUntil(0);
+    if (learned_count_ > 0) purgeLearned();
+
+    // Drop duplicates and literals false at level 0; skip clauses already satisfied
+    vector<int> lits(literals);
+    sort(lits.begin(), lits.end());
+    size_t kept = 0;
+    for (size_t i = 0; i < lits.size(); i++) {
+        int lit = lits[i];
+        if (valueOf(lit) == 1 || (i + 1 < lits.size() && lits[i + 1] == (lit ^ 1))) return true;
+        if (valueOf(lit) == 0 || (kept > 0 && lits[kept - 1] == lit)) continue;
+        lits[kept++] = lit;
+    }
+    lits.resize(kept);
+
+    if (lits.empty()) {
+        unsatisfiable_ = true;
+        return false;
+    }
+    if (lits.size() == 1) {
+        assign(lits[0], NO_REASON);
+        if (propagate() != NO_REASON) unsatisfiable_ = true;
+        return !unsatisfiable_;
+    }
+    int clause = (int) arena_.size();
+    arena_.push_back((int) lits.size());
+    arena_.insert(arena_.end(), lits.begin(), lits.end());
+    watchClause(clause);
+    base_arena_size_ = arena_.size();
+    return true;
+}
+
+int SatSolver::propagate() {
+    int conflict = NO_REASON;
+    while (queue_head_ < trail_.size()) {
+        int p = trail_[queue_head_++];
+        int falseLit = p ^ 1;
+        vector<Watcher>& watchers = watches_[p];
+        stats_.propagations++;
+
+        size_t i = 0, j = 0, n = watchers.size();
+        while (i < n) {
+            Watcher watcher = watchers[i++];
+            if (valueOf(watcher.blocker) == 1) {
+                watchers[j++] = watcher;
+                continue;
+            }
+
+            // Keep the false literal in slot 1
+            int size = arena_[watcher.clause];
+            int* lits = &arena_[watcher.clause + 1];
+            if (lits[0] == falseLit) swap(lits[0], lits[1]);
+            int first = lits[0];
+            if (first != watcher.blocker && valueOf(first) == 1) {
+                watchers[j++] = {watcher.clause, first};
+                continue;
+            }
+
+            // Look for another literal to watch
+            bool moved = false;
+            for (int k = 2; k < size; k++) {
+                if (valueOf(lits[k]) != 0) {
+                    swap(lits[1], lits[k]);
+                    watches_[lits[1] ^ 1].push_back({watcher.clause, first});
+                    moved = true;
+                    break;
+                }
+            }
+            if (moved) continue;
+
+            // The clause is unit or conflicting
+            watchers[j++] = {watcher.clause, first};
+            if (valueOf(first) == 0) {
+                conflict = watcher.clause;
+                queue_head_ = trail_.size();
+                while (i < n) watchers[j++] = watchers[i++];
+            } else {
+                assign(first, watcher.clause);
+            }
+        }
+        watchers.resize(j);
+        if (conflict != NO_REASON) break;
+    }
+    return conflict;
+}
+
+bool SatSolver::isRedundant(const int& lit) {
+    // A literal implied only by literals already in the learned clause can be left out
+    int reason = reason_[lit >> 1];
+    if (reason == NO_REASON) return false;
+    int size = arena_[reason];
+    const int* lits = &arena_[reason + 1];
+    for (int k = 1; k < size; k++) {
+        int var = lits[k] >> 1;
+        if (!seen_[var] && level_[var] > 0) return false;
+    }
+    return true;
+}
+
+void SatSolver::analyze(int conflict, vector<int>& learnt, int& backjump_level) {
+    // First-UIP: resolve the conflict with reasons of the current level until one literal is left
+    learnt.clear();
+    learnt.push_back(-1);
+    int pathCount = 0, p = -1;
+    int index = (int) trail_.size() - 1;
+    do {
+        int size = arena_[conflict];
+        const int* lits = &arena_[conflict + 1];
+        for (int j = (p == -1 ? 0 : 1); j < size; j++) {
+            int q = lits[j];
+            int var = q >> 1;
+            if (seen_[var] || level_[var] == 0) continue;
+            seen_[var] = 1;
+            bumpVar(var);
+            if (level_[var] >= decisionLevel()) pathCount++;
+            else learnt.push_back(q);
+        }
+        while (!seen_[trail_[index] >> 1]) index--;
+        p = trail_[index--];
+        conflict = reason_[p >> 1];
+        seen_[p >> 1] = 0;
+        pathCount--;
+    } while (pathCount > 0);
+    learnt[0] = p ^ 1;
+
+    analyze_stack_.assign(learnt.begin(), learnt.end());
+    size_t kept = 1;
+    for (size_t i = 1; i < learnt.size(); i++) {
+        if (!isRedundant(learnt[i])) learnt[kept++] = learnt[i];
+    }
+    learnt.resize(kept);
+    for (int lit : analyze_stack_) seen_[lit >> 1] = 0;
+
+    // Backjump to the second-highest level in the clause, which then becomes unit
+    backjump_level = 0;
+    if (learnt.size() > 1) {
+        size_t highest = 1;
+        for (size_t i = 2; i < learnt.size(); i++) {
+            if (level_[learnt[i] >> 1] > level_[learnt[highest] >> 1]) highest = i;
+        }
+        swap(learnt[1], learnt[highest]);
+        backjump_level = level_[learnt[1] >> 1];
+    }
+}
+
+void SatSolver::cancelUntil(const int& level) {
+    if (decisionLevel() <= level) return;
+    for (size_t i = trail_.size(); i-- > (size_t) trail_limits_[level];) {
+        int var = trail_[i] >> 1;
+        phase_[var] = assigns_[var];
+        assigns_[var] = UNASSIGNED;
+        if (heap_position_[var] == -1) heapInsert(var);
+    }
+    trail_.resize(trail_limits_[level]);
+    trail_limits_.resize(level);
+    queue_head_ = trail_.size();
+}
+
+int SatSolver::pickBranchLiteral() {
+    while (!heap_.empty()) {
+        int var = heapPop();
+        if (assigns_[var] == UNASSIGNED) return literal(var, phase_[var] == 1);
+    }
+    return -1;
+}
+
+void SatSolver::purgeLearned() {
+    // Called at level 0 only, where no learned clause is the reason of a decision-level literal.
+    // Short learned clauses are kept, minus their literals that are false for good.
+    for (int var = 0; var < numVars(); var++) {
+        if (reason_[var] >= (int) base_arena_size_) reason_[var] = NO_REASON;
+    }
+    for (vector<Watcher>& watchers : watches_) {
+        watchers.erase(remove_if(watchers.begin(), watchers.end(),
+                                 [this](const Watcher& w) { return w.clause >= (int) base_arena_size_; }),
+                       watchers.end());
+    }
+
+    size_t read = base_arena_size_, write = base_arena_size_;
+    learned_count_ = 0;
+    while (read < arena_.size()) {
+        int size = arena_[read];
+        size_t next = read + 1 + size;
+        if (size <= 3) {
+            int kept = 0;
+            bool satisfied = false;
+            for (size_t k = read + 1; k < next; k++) {
+                int8_t value = valueOf(arena_[k]);
+                if (value == 1) satisfied = true;
+                if (value == UNASSIGNED) arena_[write + 1 + kept++] = arena_[k];
+            }
+            if (!satisfied && kept >= 2) {
+                arena_[write] = kept;
+                watchClause((int) write);
+                write += 1 + kept;
+                learned_count_++;
+            }
+        }
+        read = next;
+    }
+    arena_.resize(write);
+    stats_.purges++;
+}
+
+void SatSolver::bumpVar(const int& var) {
+    activity_[var] += var_increment_;
+    if (activity_[var] > 1e100) {
+        for (double& activity : activity_) activity *= 1e-100;
+        var_increment_ *= 1e-100;
+    }
+    if (heap_position_[var] != -1) heapUp(heap_position_[var]);
+}
+
+void SatSolver::heapInsert(const int& var) {
+    heap_position_[var] = (int) heap_.size();
+    heap_.push_back(var);
+    heapUp((int) heap_.size() - 1);
+}
+
+int SatSolver::heapPop() {
+    int top = heap_[0];
+    heap_position_[top] = -1;
+    int last = heap_.back();
+    heap_.pop_back();
+    if (!heap_.empty()) {
+        heap_[0] = last;
+        heap_position_[last] = 0;
+        heapDown(0);
+    }
+    return top;
+}
+
+void SatSolver::heapUp(int position) {
+    int var = heap_[position];
+    while (position > 0) {
+        int parent = (position - 1) / 2;
+        if (activity_[heap_[parent]] >= activity_[var]) break;
+        heap_[position] = heap_[parent];
+        heap_position_[heap_[position]] = position;
+        position = parent;
+    }
+    heap_[position] = var;
+    heap_position_[var] = position;
+}
+
+void SatSolver::heapDown(int position) {
+    int var = heap_[position];
+    int size = (int) heap_.size();
+    for (;;) {
+        int child = 2 * position + 1;
+        if (child >= size) break;
+        if (child + 1 < size && activity_[heap_[child + 1]] > activity_[heap_[child]]) child++;
+        if (activity_[heap_[child]] <= activity_[var]) break;
+        heap_[position] = heap_[child];
+        heap_position_[heap_[position]] = position;
+        position = child;
+    }
+    heap_[position] = var;
+    heap_position_[var] = position;
+}
+
+SatSolver::Result SatSolver::solve(const vector<int>& assumptions, const long long& conflict_limit) {
+    model_.clear();
+    if (unsatisfiable_) return UNSAT;
+    cancelUntil(0);
+    if (learned_count_ > learned_limit_) purgeLearned();
+    if (propagate() != NO_REASON) {
+        unsatisfiable_ = true;
+        return UNSAT;
+    }
+
+    vector<int> learnt;
+    long long conflicts = 0, sinceRestart = 0, restartIndex = 0;
+    long long restartBudget = RESTART_UNIT * lubyTerm(restartIndex);
+    for (;;) {
+        int conflict = propagate();
+        if (conflict != NO_REASON) {
+            stats_.conflicts++;
+            conflicts++;
+            sinceRestart++;
+            if (decisionLevel() == 0) {
+                unsatisfiable_ = true;
+                return UNSAT;
+            }
+            int backjumpLevel;
+            analyze(conflict, learnt, backjumpLevel);
+            cancelUntil(backjumpLevel);
+            if (learnt.size() == 1) {
+                assign(learnt[0], NO_REASON);
+            } else {
+                int clause = (int) arena_.size();
+                arena_.push_back((int) learnt.size());
+                arena_.insert(arena_.end(), learnt.begin(), learnt.end());
+                watchClause(clause);
+                learned_count_++;
+                assign(learnt[0], clause);
+            }
+            stats_.learned++;
+            var_increment_ /= ACTIVITY_DECAY;
+            continue;
+        }
+
+        if (conflict_limit > 0 && conflicts >= conflict_limit) {
+            cancelUntil(0);
+            return UNKNOWN;
+        }
+        if (sinceRestart >= restartBudget) {
+            cancelUntil(0);
+            if (learned_count_ > learned_limit_) purgeLearned();
+            stats_.restarts++;
+            sinceRestart = 0;
+            restartBudget = RESTART_UNIT * lubyTerm(++restartIndex);
+            continue;
+        }
+
+        // Assumptions take the first decision levels, one each
+        int next = -1;
+        while (decisionLevel() < (int) assumptions.size()) {
+            int assumption = assumptions[decisionLevel()];
+            int8_t value = valueOf(assumption);
+            if (value == 1) {
+                trail_limits_.push_back((int) trail_.size());
+            } else if (value == 0) {
+                cancelUntil(0);
+                return UNSAT;
+            } else {
+                next = assumption;
+                break;
+            }
+        }
+        if (next == -1) {
+            next = pickBranchLiteral();
+            if (next == -1) {
+                model_ = assigns_;
+                cancelUntil(0);
+                return SAT;
+            }
+            stats_.decisions++;
+        }
+        trail_limits_.push_back((int) trail_.size());
+        assign(next, NO_REASON);
+    }
+}
+
+bool SatSolver::modelValue(const int& var) const {
+    return var < (int) model_.size() && model_[var] == 1;
+}
+
+void SatSolver::setLearnedLimit(const int& limit) {
+    learned_limit_ = limit;
+}
+
+const SatStats& SatSolver::stats() const {
+    return stats_;
+}
+
+// ========================= SudokuSat =========================
+
+SudokuSat::SudokuSat(const int& box_size) : box_size_(box_size), size_(box_size * box_size) {
+    const int n = size_;
+    const long long vars = (long long) n * n * n;
+    // Exactly-one over 4 * n * n groups of n literals, minus box pairs already covered by rows/columns
+    const long long pairs = (long long) 4 * n * n * n * (n - 1) / 2;
+    solver_.reserve((int) vars, 4LL * n * n + pairs, 4LL * n * n * n + 2 * pairs);
+    for (long long v = 0; v < vars; v++) solver_.newVar();
+
+    vector<int> group(n);
+    vector<int> clause(2);
+    // Every group gets at least one true literal and no two; `skip` leaves out pairs of a box
+    // that share a row or column, whose clauses the row and column groups already add
+    auto exactlyOne = [&](const bool& is_box) {
+        vector<int> atLeastOne(n);
+        for (int i = 0; i < n; i++) atLeastOne[i] = SatSolver::literal(group[i]);
+        solver_.addClause(atLeastOne);
+        for (int i = 0; i < n; i++) {
+            for (int j = i + 1; j < n; j++) {
+                if (is_box && (i / box_size_ == j / box_size_ || i % box_size_ == j % box_size_)) continue;
+                clause[0] = SatSolver::literal(group[i], false);
+                clause[1] = SatSolver::literal(group[j], false);
+                solver_.addClause(clause);
+            }
+        }
+    };
+    for (int r = 0; r < n; r++) {
+        for (int c = 0; c < n; c++) {
+            for (int d = 0; d < n; d++) group[d] = variable(r, c, d);
+            exactlyOne(false);
+        }
+    }
+    for (int d = 0; d < n; d++) {
+        for (int i = 0; i < n; i++) {
+            for (int j = 0; j < n; j++) group[j] = variable(i, j, d);
+            exactlyOne(false);
+            for (int j = 0; j < n; j++) group[j] = variable(j, i, d);
+            exactlyOne(false);
+            int top = box_size_ * (i / box_size_), left = box_size_ * (i % box_size_);
+            for (int j = 0; j < n; j++) group[j] = variable(top + j / box_size_, left + j % box_size_, d);
+            exactlyOne(true);
+        }
+    }
+    assumptions_.reserve((size_t) n * n);
+    cells_.resize((size_t) n * n);
+}
+
+int SudokuSat::size() const {
+    return size_;
+}
+
+int SudokuSat::variable(const int& r, const int& c, const int& digit) const {
+    return (r * size_ + c) * size_ + digit;
+}
+
+bool SudokuSat::solve(int* cells, const long long& conflict_limit) {
+    const int n = size_;
+    assumptions_.clear();
+    for (int i = 0; i < n * n; i++) {
+        if (cells[i] == 0) continue;
+        if (cells[i] < 0 || cells[i] > n) return false;
+        assumptions_.push_back(SatSolver::literal(variable(i / n, i % n, cells[i] - 1)));
+    }
+    if (solver_.solve(assumptions_, conflict_limit) != SatSolver::SAT) return false;
+
+    for (int i = 0; i < n * n; i++) {
+        if (cells[i] != 0) continue;
+        for (int d = 0; d < n; d++) {
+            if (solver_.modelValue(variable(i / n, i % n, d))) {
+                cells[i] = d + 1;
+                break;
+            }
+        }
+    }
+    return true;
+}
+
+bool SudokuSat::solve(int** BOARD, const long long& conflict_limit) {
+    const int n = size_;
+    for (int r = 0; r < n; r++) {
+        for (int c = 0; c < n; c++) cells_[r * n + c] = BOARD[r][c];
+    }
+    if (!solve(cells_.data(), conflict_limit)) return false;
+    for (int r = 0; r < n; r++) {
+        for (int c = 0; c < n; c++) BOARD[r][c] = cells_[r * n + c];
+    }
+    return true;
+}
+
+const SatStats& SudokuSat::stats() const {
+    return solver_.stats();
+}
@@ -0,0 +1,271 @@
+/**
+ * @file session.cpp
+ * @brief Implementation of the incremental interactive Sudoku session.
+ *
+ * Detailed function descriptions are provided in the corresponding header file.
+ *
+ * @date
+ * October 19, 2026
+ */
+
+#include "../include/session.h"
+#include <cstring>
+
+using namespace std;
+
+/**
+ * A cell the search branched on and the digits it has not tried there yet.
+ */
+struct SearchStep {
+    std::uint8_t cell;
+    std::uint16_t untried;
+};
+
+/**
+ * Working copy of a session's board for the solution search, kept on the caller's stack.
+ * The trail records every branch, so backtracking undoes placements instead of copying
+ * the grid or recursing.
+ */
+struct SessionGrid {
+    std::uint8_t cells[81];
+    std::uint16_t rows[9], cols[9], boxes[9];
+    SearchStep trail[81];
+    int depth = 0;
+
+    void load(const PackedDigits& digits, const std::uint16_t* rowMasks, const std::uint16_t* colMasks,
+              const std::uint16_t* boxMasks) {
+        for (int i = 0; i < 81; i++) cells[i] = (std::uint8_t) digits.get(i);
+        memcpy(rows, rowMasks, sizeof(rows));
+        memcpy(cols, colMasks, sizeof(cols));
+        memcpy(boxes, boxMasks, sizeof(boxes));
+    }
+
+    int candidates(const int& i) const {
+        int r = i / 9, c = i % 9;
+        return ~(rows[r] | cols[c] | boxes[3 * (r / 3) + c / 3]) & 0x1FF;
+    }
+
+    void place(const int& i, const int& bit) {
+        int r = i / 9, c = i % 9;
+        cells[i] = (std::uint8_t) (__builtin_ctz(bit) + 1);
+        rows[r] |= bit; cols[c] |= bit; boxes[3 * (r / 3) + c / 3] |= bit;
+    }
+
+    void remove(const int& i) {
+        int r = i / 9, c = i % 9, bit = 1 << (cells[i] - 1);
+        cells[i] = 0;
+        rows[r] ^= bit; cols[c] ^= bit; boxes[3 * (r / 3) + c / 3] ^= bit;
+    }
+};
+
+/**
+ * Checks that every digit missing from a row, column or box still has a place in it.
+ */
+static bool unitsCovered(const SessionGrid& grid)
+{
+    int rowPlaces[9] = {0}, colPlaces[9] = {0}, boxPlaces[9] = {0};
+    for (int i = 0; i < 81; i++) {
+        if (grid.cells[i] != 0) continue;
+        int r = i / 9, c = i % 9, b = 3 * (r / 3) + c / 3;
+        int mask = grid.candidates(i);
+        rowPlaces[r] |= mask; colPlaces[c] |= mask; boxPlaces[b] |= mask;
+    }
+    for (int u = 0; u < 9; u++) {
+        if ((rowPlaces[u] | grid.rows[u]) != 0x1FF) return false;
+        if ((colPlaces[u] | grid.cols[u]) != 0x1FF) return false;
+        if ((boxPlaces[u] | grid.boxes[u]) != 0x1FF) return false;
+    }
+    return true;
+}
+
+/**
+ * Fills the grid with a solution, branching on the cell with the fewest candidates.
+ * Returns false (with the grid as it was) if there is none.
+ */
+static bool searchFrom(SessionGrid& grid)
+{
+    while (true) {
+        int bestCell = -1, bestMask = 0, bestCount = 10;
+        for (int i = 0; i < 81; i++) {
+            if (grid.cells[i] != 0) continue;
+            int mask = grid.candidates(i);
+            int options = __builtin_popcount(mask);
+            if (options < bestCount) {
+                bestCell = i;
+                bestMask = mask;
+                bestCount = options;
+                if (options <= 1) break;
+            }
+        }
+        if (bestCell == -1) return true;
+
+        if (bestCount > 0 && (bestCount == 1 || unitsCovered(grid))) {
+            grid.trail[grid.depth].cell = (std::uint8_t) bestCell;
+            grid.trail[grid.depth].untried = (std::uint16_t) bestMask;
+            grid.depth++;
+        } else {
+            // Dead end: undo back to the latest branch with a digit left to try
+            while (grid.depth > 0 && grid.trail[grid.depth - 1].untried == 0) {
+                grid.depth--;
+                grid.remove(grid.trail[grid.depth].cell);
+            }
+            if (grid.depth == 0) return false;
+            grid.remove(grid.trail[grid.depth - 1].cell);
+        }
+
+        SearchStep& step = grid.trail[grid.depth - 1];
+        int bit = step.untried & -step.untried;
+        step.untried ^= bit;
+        grid.place(step.cell, bit);
+    }
+}
+
+SudokuSession::SudokuSession(int** BOARD) {
+    for (int r = 0; r < 9; r++) {
+        for (int c = 0; c < 9; c++) {
+            int k = BOARD[r][c];
+            if (k >= 1 && k <= 9) set(r, c, k);
+        }
+    }
+}
+
+int SudokuSession::get(const int& r, const int& c) const {
+    return cells_.get(r * 9 + c);
+}
+
+int SudokuSession::candidates(const int& r, const int& c) const {
+    if (cells_.get(r * 9 + c) != 0) return 0;
+    return ~(rows_[r] | cols_[c] | boxes_[boxOf(r, c)]) & 0x1FF;
+}
+
+bool SudokuSession::isLegal(const int& r, const int& c, const int& k) const {
+    if (r < 0 || r > 8 || c < 0 || c > 8 || k < 1 || k > 9) return false;
+    return (candidates(r, c) >> (k - 1)) & 1;
+}
+
+bool SudokuSession::set(const int& r, const int& c, const int& k) {
+    if (!isLegal(r, c, k)) return false;
+    int bit = 1 << (k - 1);
+    cells_.set(r * 9 + c, k);
+    rows_[r] |= bit; cols_[c] |= bit; boxes_[boxOf(r, c)] |= bit;
+    empty_--;
+    if (solutionValid_ && solution_.get(r * 9 + c) != k) solutionValid_ = false;
+    return true;
+}
+
+void SudokuSession::clear(const int& r, const int& c) {
+    if (r < 0 || r > 8 || c < 0 || c > 8) return;
+    int k = cells_.get(r * 9 + c);
+    if (k == 0) return;
+    int bit = 1 << (k - 1);
+    cells_.set(r * 9 + c, 0);
+    rows_[r] ^= bit; cols_[c] ^= bit; boxes_[boxOf(r, c)] ^= bit;
+    empty_++;
+    // Fewer clues can only add solutions, so a cached solution still holds
+    unsolvable_ = false;
+}
+
+int SudokuSession::emptyCount() const {
+    return empty_;
+}
+
+bool SudokuSession::searchSolution(const int& cell, const int& k) {
+    SessionGrid grid;
+    grid.load(cells_, rows_, cols_, boxes_);
+    if (cell >= 0) grid.place(cell, 1 << (k - 1));
+    if (!searchFrom(grid)) return false;
+    for (int i = 0; i < 81; i++) solution_.set(i, grid.cells[i]);
+    return true;
+}
+
+bool SudokuSession::isSolvable() {
+    if (solutionValid_) return true;
+    if (unsolvable_) return false;
+    solutionValid_ = searchSolution();
+    unsolvable_ = !solutionValid_;
+    return solutionValid_;
+}
+
+bool SudokuSession::wouldStaySolvable(const int& r, const int& c, const int& k) {
+    if (!isLegal(r, c, k)) return false;
+    if (solutionValid_ && solution_.get(r * 9 + c) == k) return true;
+    if (unsolvable_) return false;
+
+    // Search with the move placed on the scratch grid only, so the board and a cached
+    // solution stay untouched if it fails; a solution found with it is also one without it
+    if (!searchSolution(r * 9 + c, k)) return false;
+    solutionValid_ = true;
+    return true;
+}
+
+bool SudokuSession::nextForcedCell(CellMove& move) const {
+    // Naked singles
+    for (int i = 0; i < 81; i++) {
+        if (cells_.get(i) != 0) continue;
+        int mask = candidates(i / 9, i % 9);
+        if (mask != 0 && (mask & (mask - 1)) == 0) {
+            move.row = i / 9;
+            move.col = i % 9;
+            move.value = __builtin_ctz(mask) + 1;
+            return true;
+        }
+    }
+
+    // Hidden singles: unit u is row u, column u - 9 or box u - 18
+    for (int u = 0; u < 27; u++) {
+        int seenOnce = 0, seenTwice = 0;
+        int cellsOf[9];
+        for (int j = 0; j < 9; j++) {
+            int r, c;
+            if (u < 9) { r = u; c = j; }
+            else if (u < 18) { r = j; c = u - 9; }
+            else { r = 3 * ((u - 18) / 3) + j / 3; c = 3 * ((u - 18) % 3) + j % 3; }
+            cellsOf[j] = r * 9 + c;
+            int mask = candidates(r, c);
+            seenTwice |= seenOnce & mask;
+            seenOnce |= mask;
+        }
+        int unique = seenOnce & ~seenTwice;
+        if (unique == 0) continue;
+        int bit = unique & -unique;
+        for (int j = 0; j < 9; j++) {
+            int i = cellsOf[j];
+            if (candidates(i / 9, i % 9) & bit) {
+                move.row = i / 9;
+                move.col = i % 9;
+                move.value = __builtin_ctz(bit) + 1;
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+bool SudokuSession::hint(CellMove& move) {
+    if (empty_ == 0 || !isSolvable()) return false;
+    if (nextForcedCell(move)) return true;
+
+    int bestCell = -1, bestCount = 10;
+    for (int i = 0; i < 81; i++) {
+        if (cells_.get(i) != 0) continue;
+        int options = __builtin_popcount(candidates(i / 9, i % 9));
+        if (options < bestCount) {
+            bestCell = i;
+            bestCount = options;
+        }
+    }
+    move.row = bestCell / 9;
+    move.col = bestCell % 9;
+    move.value = solution_.get(bestCell);
+    return true;
+}
+
+bool SudokuSession::solution(int** BOARD) {
+    if (!isSolvable()) return false;
+    for (int i = 0; i < 81; i++) BOARD[i / 9][i % 9] = solution_.get(i);
+    return true;
+}
+
+void SudokuSession::copyTo(int** BOARD) const {
+    for (int i = 0; i < 81; i++) BOARD[i / 9][i % 9] = cells_.get(i);
+}
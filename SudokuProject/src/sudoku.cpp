@@ -14,8 +14,19 @@
 */
 
 #include "../include/sudoku.h"
+#include "../include/sat_solver.h"
+#include "../include/solver_policies.h"
+#include "../include/sudoku_io.h"
+#include "../include/utils.h"
 #include <iostream>
 #include <tuple>
+#include <climits>
+#include <vector>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <random>
+#include <algorithm>
 using namespace std;
 
 bool isValid(int** BOARD, const int& r, const int& c, const int& k)
@@ -46,40 +57,11 @@ bool isValid(int** BOARD, const int& r, const int& c, const int& k)
 
 bool solveBoard(int** BOARD, const int& r, const int& c)
 {
-    // If we've reached beyond the last row, the board is solved
-    if (r == 9)
-        return true;
-
-    // Move to the next row if we've reached the end of the current row
-    if (c == 9)
-        return solveBoard(BOARD, r + 1, 0);
-
-    // Skip already filled cells and move to the next column
-    if (BOARD[r][c] != 0)
-        return solveBoard(BOARD, r, c + 1);
-
-    // Try placing numbers 1 to 9 in the current empty cell
-    for (int k = 1; k <= 9; k++)
-    {
-        if (isValid(BOARD, r, c, k))
-        {
-            BOARD[r][c] = k;  // Place number 'k'
-
-            // Recursively attempt to solve the rest of the board
-            if (solveBoard(BOARD, r, c + 1))
-                return true;  // Found a valid solution
-
-            // Backtrack: Remove the number if no solution is found
-            BOARD[r][c] = 0;
-        }
-    }
-
-    // Trigger backtracking if no valid number can be placed
-    return false;
+    // Row-major cells from (r, c), digits 1 to 9, no propagation
+    return SequentialSolver::run(BOARD, -1, nullptr, r * 9 + c) == SEARCH_SOLVED;
 }
 
 
-
 tuple<int, int, int> findNextCell(int** BOARD) {
     int minOptions = INT_MAX;
     int bestRow = -1, bestCol = -1;
@@ -110,26 +92,513 @@ tuple<int, int, int> findNextCell(int** BOARD) {
 
 bool solveBoardEfficient(int** BOARD)
 {
+    // Fewest-candidates cell (as chosen by findNextCell()), digits 1 to 9, no propagation
+    return MrvSolver::solve(BOARD);
+}
+
+
+/**
+ * State shared by one attempt of solveBoardWithOptions().
+ */
+struct OrderedSearch {
+    ValueOrder order;
+    bool randomTies;
+    long long budget;   // nodes left in this attempt (negative means unlimited)
+    long long nodes;
+    mt19937 generator;
+};
+
+/**
+ * Number of candidates digit k would remove from the empty peers of (r, c).
+ */
+static int eliminatedBy(int** BOARD, const int& r, const int& c, const int& k)
+{
+    int eliminated = 0;
+    int boxRow = 3 * (r / 3), boxCol = 3 * (c / 3);
+    for (int i = 0; i < 9; i++) {
+        if (i != c && BOARD[r][i] == 0 && isValid(BOARD, r, i, k)) eliminated++;
+        if (i != r && BOARD[i][c] == 0 && isValid(BOARD, i, c, k)) eliminated++;
+        int br = boxRow + i / 3, bc = boxCol + i % 3;
+        if (br != r && bc != c && BOARD[br][bc] == 0 && isValid(BOARD, br, bc, k)) eliminated++;
+    }
+    return eliminated;
+}
+
+static SearchResult searchOrdered(int** BOARD, OrderedSearch& search)
+{
+    if (search.budget == 0) return SEARCH_ABORTED;
+    if (search.budget > 0) search.budget--;
+    search.nodes++;
+
     auto [r, c, k] = findNextCell(BOARD);
     if (r == -1 || c == -1) {
+        return SEARCH_SOLVED;
+    }
+
+    int digits[9];
+    int count = 0;
+    for (int i = 1; i < 10; i++) {
+        if (isValid(BOARD, r, c, i)) digits[count++] = i;
+    }
+    if (search.order == RANDOM_ORDER || search.randomTies) {
+        shuffle(digits, digits + count, search.generator);
+    }
+    if (search.order == LEAST_CONSTRAINING && count > 1) {
+        int cost[10];
+        for (int i = 0; i < count; i++) cost[digits[i]] = eliminatedBy(BOARD, r, c, digits[i]);
+        stable_sort(digits, digits + count, [&](int a, int b) { return cost[a] < cost[b]; });
+    }
+
+    for (int i = 0; i < count; i++) {
+        BOARD[r][c] = digits[i];
+        SearchResult result = searchOrdered(BOARD, search);
+        if (result == SEARCH_SOLVED) return result;
+        BOARD[r][c] = 0;
+        if (result == SEARCH_ABORTED) return result;
+    }
+    return SEARCH_EXHAUSTED;
+}
+
+/**
+ * i-th element (1-based) of the Luby sequence 1, 1, 2, 1, 1, 2, 4, 1, 1, 2, ...
+ */
+static long long luby(long long i)
+{
+    for (;;) {
+        long long power = 1;
+        while (power * 2 - 1 < i) power *= 2;
+        if (power * 2 - 1 == i) return power;
+        i -= power - 1;
+    }
+}
+
+/**
+ * true if two clues of the board share a digit in a row, column or box. isValid() only
+ * guards the digits the search places, so such a board would otherwise be "solved".
+ */
+static bool cluesClash(int** BOARD)
+{
+    int rows[9] = {0}, cols[9] = {0}, boxes[9] = {0};
+    for (int r = 0; r < 9; r++) {
+        for (int c = 0; c < 9; c++) {
+            if (BOARD[r][c] < 1 || BOARD[r][c] > 9) continue;
+            int bit = 1 << (BOARD[r][c] - 1);
+            int b = 3 * (r / 3) + c / 3;
+            if ((rows[r] | cols[c] | boxes[b]) & bit) return true;
+            rows[r] |= bit; cols[c] |= bit; boxes[b] |= bit;
+        }
+    }
+    return false;
+}
+
+bool solveBoardWithOptions(int** BOARD, const SearchOptions& options, long long* nodes)
+{
+    if (cluesClash(BOARD)) {
+        if (nodes != nullptr) *nodes = 0;
+        return false;
+    }
+
+    OrderedSearch search;
+    search.order = options.order;
+    search.randomTies = false;
+    search.nodes = 0;
+    search.generator.seed(options.seed != 0 ? options.seed : random_device()());
+
+    SearchResult result = SEARCH_ABORTED;
+    double geometricBudget = (double) max(1LL, options.restart_base);
+    for (long long attempt = 1; result == SEARCH_ABORTED; attempt++) {
+        long long budget = -1;
+        if (options.restarts == LUBY_RESTARTS) {
+            budget = max(1LL, options.restart_base) * luby(attempt);
+        } else if (options.restarts == GEOMETRIC_RESTARTS) {
+            budget = (long long) geometricBudget;
+            geometricBudget *= max(1.0, options.restart_factor);
+        }
+        if (options.node_limit > 0) {
+            long long left = options.node_limit - search.nodes;
+            if (left <= 0) break;
+            if (budget < 0 || budget > left) budget = left;
+        }
+        search.budget = budget;
+        result = searchOrdered(BOARD, search);
+
+        // Later attempts need a different order to explore a different part of the tree
+        if (search.order == ASCENDING) search.order = RANDOM_ORDER;
+        search.randomTies = true;
+    }
+
+    if (nodes != nullptr) *nodes = search.nodes;
+    return result == SEARCH_SOLVED;
+}
+
+// ========================= Adaptive Dispatch ============================
+
+static DispatchThresholds dispatchThresholds;
+
+void setDispatchThresholds(const DispatchThresholds& thresholds)
+{
+    dispatchThresholds = thresholds;
+}
+
+DispatchThresholds getDispatchThresholds()
+{
+    return dispatchThresholds;
+}
+
+/**
+ * Fills naked singles until none are left. Counts the remaining empty cells and their
+ * total number of candidates. Returns false if the clues conflict or a cell has no candidate.
+ */
+static bool propagateSingles(int** BOARD, int& empty, int& candidates)
+{
+    int rows[9] = {0}, cols[9] = {0}, boxes[9] = {0};
+    for (int r = 0; r < 9; r++) {
+        for (int c = 0; c < 9; c++) {
+            if (BOARD[r][c] == 0) continue;
+            int bit = 1 << (BOARD[r][c] - 1);
+            int b = 3 * (r / 3) + c / 3;
+            if ((rows[r] | cols[c] | boxes[b]) & bit) return false;
+            rows[r] |= bit; cols[c] |= bit; boxes[b] |= bit;
+        }
+    }
+
+    bool changed = true;
+    while (changed) {
+        changed = false;
+        empty = 0;
+        candidates = 0;
+        for (int r = 0; r < 9; r++) {
+            for (int c = 0; c < 9; c++) {
+                if (BOARD[r][c] != 0) continue;
+                int b = 3 * (r / 3) + c / 3;
+                int mask = ~(rows[r] | cols[c] | boxes[b]) & 0x1FF;
+                if (mask == 0) return false;
+                if ((mask & (mask - 1)) == 0) {
+                    BOARD[r][c] = __builtin_ctz(mask) + 1;
+                    rows[r] |= mask; cols[c] |= mask; boxes[b] |= mask;
+                    changed = true;
+                } else {
+                    empty++;
+                    candidates += __builtin_popcount(mask);
+                }
+            }
+        }
+    }
+    return true;
+}
+
+/**
+ * Options of the restart engine. The seed is fixed so that a board always gets the same
+ * solution, which keeps batch runs reproducible (and resumable) on puzzles with several.
+ */
+static SearchOptions restartOptions()
+{
+    SearchOptions options;
+    options.order = RANDOM_ORDER;
+    options.restarts = LUBY_RESTARTS;
+    options.seed = 0x5EED;
+    return options;
+}
+
+bool solveAdaptive(int** BOARD, DispatchDecision* decision)
+{
+    DispatchDecision local;
+    DispatchDecision& d = decision != nullptr ? *decision : local;
+    d = DispatchDecision();
+
+    int saved[81];
+    for (int i = 0; i < 81; i++) saved[i] = BOARD[i / 9][i % 9];
+    auto restore = [&]() {
+        for (int i = 0; i < 81; i++) BOARD[i / 9][i % 9] = saved[i];
+    };
+
+    int candidates = 0;
+    if (!propagateSingles(BOARD, d.empty, candidates)) {
+        restore();
+        return false;
+    }
+    if (d.empty == 0) {
+        d.propagated = true;
         return true;
     }
+    d.density = (double) candidates / d.empty;
+
+    const DispatchThresholds thresholds = dispatchThresholds;
+    if (d.empty <= thresholds.sequential_max_empty && d.density <= thresholds.sequential_max_density) {
+        d.engine = BASIC_SOLVER;
+        SearchResult result = SequentialSolver::run(BOARD, thresholds.sequential_node_budget);
+        if (result == SEARCH_SOLVED) return true;
+        if (result == SEARCH_EXHAUSTED) {
+            restore();
+            return false;
+        }
+        d.escalated = true;
+    }
+
+    d.engine = RESTART_SOLVER;
+    if (solveBoardWithOptions(BOARD, restartOptions())) return true;
+    restore();
+    return false;
+}
+
+bool solve(int** board, const SolverKind& kind) {
+    switch (kind) {
+        case BASIC_SOLVER: return solveBoard(board, 0, 0);
+        case EFFICIENT_SOLVER: return solveBoardEfficient(board);
+        case RESTART_SOLVER: return solveBoardWithOptions(board, restartOptions());
+        case ADAPTIVE_SOLVER: return solveAdaptive(board);
+        case SAT_SOLVER: {
+            // Encoded once per thread; clauses learned on earlier boards are reused
+            thread_local SudokuSat sat(3);
+            return sat.solve(board);
+        }
+    }
+    return false;
+}
+
+bool solve(int** board, const bool& efficient) {
+    return solve(board, efficient ? EFFICIENT_SOLVER : BASIC_SOLVER);
+}
+
+// ========================= Boards of Any Size ===========================
+
+/**
+ * Board state of solveBoardOfSize(): used-digit bitmasks per row, column and box.
+ */
+struct SizedGrid {
+    int* cells;
+    int box_size, size;
+    vector<unsigned> rows, cols, boxes;
+    long long nodes, node_limit;
+};
+
+static SearchResult searchSized(SizedGrid& grid)
+{
+    const int n = grid.size;
+    const unsigned all = n == 32 ? ~0u : (1u << n) - 1;
+    int bestCell = -1, bestCount = n + 1;
+    unsigned bestMask = 0;
+    for (int i = 0; i < n * n; i++) {
+        if (grid.cells[i] != 0) continue;
+        int r = i / n, c = i % n, b = grid.box_size * (r / grid.box_size) + c / grid.box_size;
+        unsigned mask = ~(grid.rows[r] | grid.cols[c] | grid.boxes[b]) & all;
+        int options = __builtin_popcount(mask);
+        if (options < bestCount) {
+            bestCell = i;
+            bestMask = mask;
+            bestCount = options;
+            if (options <= 1) break;
+        }
+    }
+    if (bestCell == -1) return SEARCH_SOLVED;
+    if (grid.node_limit > 0 && grid.nodes >= grid.node_limit) return SEARCH_ABORTED;
+    grid.nodes++;
+
+    int r = bestCell / n, c = bestCell % n, b = grid.box_size * (r / grid.box_size) + c / grid.box_size;
+    while (bestMask != 0) {
+        unsigned bit = bestMask & -bestMask;
+        bestMask ^= bit;
+        grid.cells[bestCell] = __builtin_ctz(bit) + 1;
+        grid.rows[r] |= bit; grid.cols[c] |= bit; grid.boxes[b] |= bit;
+        SearchResult result = searchSized(grid);
+        grid.rows[r] ^= bit; grid.cols[c] ^= bit; grid.boxes[b] ^= bit;
+        if (result == SEARCH_SOLVED) return result;
+        if (result == SEARCH_ABORTED) {
+            grid.cells[bestCell] = 0;
+            return result;
+        }
+    }
+    grid.cells[bestCell] = 0;
+    return SEARCH_EXHAUSTED;
+}
+
+bool solveBoardOfSize(int* cells, const int& box_size, const long long& node_limit, long long* nodes)
+{
+    if (nodes != nullptr) *nodes = 0;
+    if (box_size < 1 || box_size > 5) return false;
+    const int n = box_size * box_size;
+    SizedGrid grid {cells, box_size, n, vector<unsigned>(n), vector<unsigned>(n), vector<unsigned>(n), 0, node_limit};
+    for (int i = 0; i < n * n; i++) {
+        if (cells[i] == 0) continue;
+        if (cells[i] < 0 || cells[i] > n) return false;
+        unsigned bit = 1u << (cells[i] - 1);
+        int r = i / n, c = i % n, b = box_size * (r / box_size) + c / box_size;
+        if ((grid.rows[r] | grid.cols[c] | grid.boxes[b]) & bit) return false;
+        grid.rows[r] |= bit; grid.cols[c] |= bit; grid.boxes[b] |= bit;
+    }
+    bool solved = searchSized(grid) == SEARCH_SOLVED;
+    if (nodes != nullptr) *nodes = grid.nodes;
+    return solved;
+}
+
+// ========================= Solution Enumeration =========================
+
+/**
+ * Depth-first walk over every completion of BOARD. onSolution is called for each filled
+ * board and returns false to stop; `stop` lets other threads cancel the walk.
+ * Returns false once the enumeration has been stopped.
+ */
+static bool enumerateFrom(int** BOARD, const function<bool(int**)>& onSolution, const atomic<bool>& stop)
+{
+    if (stop.load(memory_order_relaxed)) {
+        return false;
+    }
+    auto [r, c, k] = findNextCell(BOARD);
+    if (r == -1 || c == -1) {
+        return onSolution(BOARD);
+    }
     for (int i = 1; i < 10; i++) {
         if (isValid(BOARD, r, c, i)) {
             BOARD[r][c] = i;
-            if (solveBoardEfficient(BOARD)) {
-                return true;
-            }
+            bool keepGoing = enumerateFrom(BOARD, onSolution, stop);
             BOARD[r][c] = 0;
+            if (!keepGoing) {
+                return false;
+            }
         }
     }
-    return false;
+    return true;
 }
 
+long long enumerateSolutions(int** BOARD, const function<bool(int**)>& callback, const long long& limit)
+{
+    if (cluesClash(BOARD)) return 0;
+    long long count = 0;
+    atomic<bool> stop(false);
+    enumerateFrom(BOARD, [&](int** solved) {
+        count++;
+        return callback(solved) && (limit <= 0 || count < limit);
+    }, stop);
+    return count;
+}
 
-bool solve(int** board, const bool& efficient) {
-    if (efficient) {
-        return solveBoardEfficient(board);
+/**
+ * Board state used by countSolutions(): cell values plus a used-digit bitmask
+ * (bit d-1 set for digit d) per row, column and box.
+ */
+struct MaskState {
+    int cells[81];
+    int rows[9], cols[9], boxes[9];
+};
+
+static int countFrom(MaskState& state, const int& limit)
+{
+    int bestCell = -1, bestMask = 0, bestCount = 10;
+    for (int i = 0; i < 81; i++) {
+        if (state.cells[i] != 0) continue;
+        int r = i / 9, c = i % 9;
+        int mask = ~(state.rows[r] | state.cols[c] | state.boxes[3 * (r / 3) + c / 3]) & 0x1FF;
+        int options = __builtin_popcount(mask);
+        if (options < bestCount) {
+            bestCell = i;
+            bestMask = mask;
+            bestCount = options;
+            if (options <= 1) break;
+        }
+    }
+    if (bestCell == -1) return 1;
+    if (bestCount == 0) return 0;
+
+    int r = bestCell / 9, c = bestCell % 9, b = 3 * (r / 3) + c / 3;
+    int found = 0;
+    while (bestMask != 0 && found < limit) {
+        int bit = bestMask & -bestMask;
+        bestMask ^= bit;
+        state.cells[bestCell] = __builtin_ctz(bit) + 1;
+        state.rows[r] |= bit; state.cols[c] |= bit; state.boxes[b] |= bit;
+        found += countFrom(state, limit - found);
+        state.rows[r] ^= bit; state.cols[c] ^= bit; state.boxes[b] ^= bit;
+    }
+    state.cells[bestCell] = 0;
+    return found;
+}
+
+int countSolutions(int** BOARD, const int& limit)
+{
+    MaskState state {};
+    for (int r = 0; r < 9; r++) {
+        for (int c = 0; c < 9; c++) {
+            int k = BOARD[r][c];
+            state.cells[r * 9 + c] = k;
+            if (k == 0) continue;
+            int bit = 1 << (k - 1);
+            int b = 3 * (r / 3) + c / 3;
+            // A clue that repeats a digit in its row, column or box has no solution
+            if ((state.rows[r] | state.cols[c] | state.boxes[b]) & bit) return 0;
+            state.rows[r] |= bit; state.cols[c] |= bit; state.boxes[b] |= bit;
+        }
+    }
+    return limit > 0 ? countFrom(state, limit) : 0;
+}
+
+long long enumerateSolutionsParallel(int** BOARD, const function<bool(int**)>& callback,
+                                     const long long& limit, const int& num_threads)
+{
+    if (cluesClash(BOARD)) return 0;
+    int workers = num_threads > 0 ? num_threads : (int) thread::hardware_concurrency();
+    if (workers < 1) workers = 1;
+
+    // Split the search tree breadth-first until there is enough work to balance.
+    // Solved boards are kept as tasks, dead ends are dropped.
+    vector<int**> tasks {deepCopyBoard(BOARD)};
+    const size_t targetTasks = (size_t) workers * 8;
+    for (int depth = 0; depth < 81 && tasks.size() < targetTasks; depth++) {
+        vector<int**> next;
+        bool expanded = false;
+        for (int** task : tasks) {
+            auto [r, c, k] = findNextCell(task);
+            if (r == -1 || c == -1) {
+                next.push_back(task);
+                continue;
+            }
+            for (int i = 1; i < 10; i++) {
+                if (isValid(task, r, c, i)) {
+                    int** child = deepCopyBoard(task);
+                    child[r][c] = i;
+                    next.push_back(child);
+                }
+            }
+            deallocateBoard(task);
+            expanded = true;
+        }
+        tasks.swap(next);
+        if (!expanded) break;
     }
-        return solveBoard(board, 0, 0);
-}
\ No newline at end of file
+
+    atomic<bool> stop(false);
+    atomic<size_t> nextTask(0);
+    mutex callbackMutex;
+    long long count = 0;
+
+    auto onSolution = [&](int** solved) {
+        lock_guard<mutex> lock(callbackMutex);
+        if (stop.load(memory_order_relaxed)) {
+            return false;
+        }
+        count++;
+        if (!callback(solved) || (limit > 0 && count >= limit)) {
+            stop.store(true, memory_order_relaxed);
+            return false;
+        }
+        return true;
+    };
+
+    vector<thread> pool;
+    for (int w = 0; w < workers; w++) {
+        pool.emplace_back([&]() {
+            for (size_t t = nextTask++; t < tasks.size(); t = nextTask++) {
+                if (!enumerateFrom(tasks[t], onSolution, stop)) {
+                    break;
+                }
+            }
+        });
+    }
+    for (thread& worker : pool) {
+        worker.join();
+    }
+
+    for (int** task : tasks) {
+        deallocateBoard(task);
+    }
+    return count;
+}
@@ -0,0 +1,93 @@
+/**
+ * @file sudoku_api.cpp
+ * @brief Implementation of the embeddable C++ API and its C ABI.
+ *
+ * Detailed function descriptions are provided in the corresponding header files.
+ *
+ * @date
+ * October 19, 2026
+ */
+
+#include "../include/sudoku_api.h"
+#include "../include/sudoku.h"
+
+using namespace std;
+
+/**
+ * Checks that every row, column and box of `cells` holds each digit at most once (or,
+ * with `complete`, exactly once) and that every cell is in 0..9.
+ */
+static bool checkUnits(const int* cells, const bool& complete)
+{
+    int rows[9] = {0}, cols[9] = {0}, boxes[9] = {0};
+    for (int i = 0; i < 81; i++) {
+        int k = cells[i];
+        if (k < 0 || k > 9 || (complete && k == 0)) return false;
+        if (k == 0) continue;
+        int bit = 1 << (k - 1);
+        int r = i / 9, c = i % 9, b = 3 * (r / 3) + c / 3;
+        if ((rows[r] | cols[c] | boxes[b]) & bit) return false;
+        rows[r] |= bit; cols[c] |= bit; boxes[b] |= bit;
+    }
+    return true;
+}
+
+namespace sudoku {
+
+Status solve(int* cells, const Engine& engine) {
+    if (cells == nullptr || !checkUnits(cells, false)) return Status::InvalidInput;
+    if (engine < Engine::Basic || engine > Engine::Sat) return Status::InvalidInput;
+
+    // Row pointers into the caller's buffer, so the int** solvers work on it directly
+    int* rows[9];
+    for (int r = 0; r < 9; r++) rows[r] = cells + 9 * r;
+    return ::solve(rows, (SolverKind) engine) ? Status::Solved : Status::NoSolution;
+}
+
+size_t solveBatch(int* cells, const size_t& count, const Engine& engine, Status* statuses) {
+    size_t solved = 0;
+    for (size_t i = 0; i < count; i++) {
+        Status status = solve(cells + i * CELLS, engine);
+        if (status == Status::Solved) solved++;
+        if (statuses != nullptr) statuses[i] = status;
+    }
+    return solved;
+}
+
+bool hasValidClues(const int* cells) {
+    return cells != nullptr && checkUnits(cells, false);
+}
+
+bool isValidSolution(const int* cells) {
+    return cells != nullptr && checkUnits(cells, true);
+}
+
+}  // namespace sudoku
+
+// ========================= C ABI ========================================
+
+extern "C" {
+
+sudoku_status sudoku_solve(int* cells, sudoku_engine engine) {
+    return (sudoku_status) sudoku::solve(cells, (sudoku::Engine) engine);
+}
+
+size_t sudoku_solve_batch(int* cells, size_t count, sudoku_engine engine, sudoku_status* statuses) {
+    size_t solved = 0;
+    for (size_t i = 0; i < count; i++) {
+        sudoku_status status = sudoku_solve(cells + i * SUDOKU_CELLS, engine);
+        if (status == SUDOKU_SOLVED) solved++;
+        if (statuses != NULL) statuses[i] = status;
+    }
+    return solved;
+}
+
+int sudoku_has_valid_clues(const int* cells) {
+    return sudoku::hasValidClues(cells) ? 1 : 0;
+}
+
+int sudoku_is_valid_solution(const int* cells) {
+    return sudoku::isValidSolution(cells) ? 1 : 0;
+}
+
+}
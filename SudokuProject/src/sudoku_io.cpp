@@ -9,8 +9,21 @@
 #include <regex>
 #include <chrono>
 #include <iomanip>  // For formatted output
+#include <functional>
+#include <thread>
+#include <atomic>
+#include <memory>
+#include <cmath>
 
+#include "../include/batch_io.h"
 #include "../include/generator.h"
+#include "../include/difficulty.h"
+#include "../include/journal.h"
+#include "../include/metrics.h"
+#include "../include/perf_counters.h"
+#include "../include/sat_solver.h"
+#include "../include/session.h"
+#include "../include/solver_policies.h"
 #include "../include/sudoku_io.h"
 #include "../include/utils.h"
 #include "../include/sudoku.h"
@@ -73,10 +86,15 @@ bool writeSudokuToFile(int** BOARD, const string& filename) {
     string content;
     boardToString(BOARD, content);
     ofstream outFile(filename); // Open file for writing
+    if (!outFile.is_open()) {
+        // The shard folder may not exist yet; create it and try once more
+        error_code ec;
+        filesystem::create_directories(filesystem::path(filename).parent_path(), ec);
+        outFile.open(filename);
+    }
     if (outFile.is_open()) {
         outFile << content; // Write content to file
         outFile.close(); // Close the file
-        cout << "Content has been written to the file: " << filename << endl;
         return true;
     }
     cerr << "Unable to open file: " << filename << endl;
@@ -111,19 +129,23 @@ void fillBoard(const vector<int>& numbers, int **BOARD){
     }
 }
 
-int** readSudokuFromFile(const string& filename){
+int** parseSudoku(string sudoku){
     int** BOARD = new int*[9];
     vector<int> numbers;
 
-    ifstream file(filename);
-    string sudoku = string(istreambuf_iterator<char>(file), istreambuf_iterator<char>());
-
     replaceCharacter(sudoku, '-', '0');
     extractNumbers(sudoku, numbers);
+    numbers.resize(81, 0);  // A truncated file gives empty cells instead of reading past the end
     fillBoard(numbers, BOARD);
     return BOARD;
 }
 
+int** readSudokuFromFile(const string& filename){
+    ifstream file(filename);
+    string sudoku = string(istreambuf_iterator<char>(file), istreambuf_iterator<char>());
+    return parseSudoku(sudoku);
+}
+
 bool checkIfSolutionIsValid(int** BOARD){
     for(int r = 0; r < 9; r++) {
         for(int c = 0; c < 9; c++) {
@@ -143,73 +165,353 @@ bool checkIfSolutionIsValid(int** BOARD){
 
 vector<string> getAllSudokuInFolder(const string& folderPath){
     vector<std::string> sudokus;
-    for (const auto& entry : filesystem::directory_iterator(folderPath)) {
-        if (filesystem::is_regular_file(entry)) {
+    for (const auto& entry : filesystem::recursive_directory_iterator(folderPath)) {
+        if (entry.is_regular_file()) {
             sudokus.push_back(entry.path().string());
         }
     }
     cout << sudokus.size() << " Sudoku Puzzle found @ " << folderPath << endl;
-    cout << setfill('-') << setw(55)<< "" << setfill(' ') <<endl;
-    cout << setw(5) << "Index" << setw(50) << "File Name" << endl;
-    cout << setfill('-') << setw(55)<< "" << setfill(' ') <<endl;
-    for(int i = 0; i < sudokus.size(); i++)
-        cout << setw(5) << i << setw(50) << sudokus[i] << endl;
-    cout << setfill('-') << setw(55)<< "" << setfill(' ') <<endl;
     return sudokus;
 }
 
-void createAndSaveNPuzzles(const int& num_puzzles, const int& complexity_empty_boxes, const string& destination, const string& prefix){
+long long streamSudokuInFolder(const string& folderPath, BoundedQueue<string>& paths){
+    long long found = 0;
+    error_code ec;
+    for (auto it = filesystem::recursive_directory_iterator(folderPath, ec);
+         !ec && it != filesystem::recursive_directory_iterator(); it.increment(ec)) {
+        if (it->is_regular_file() && paths.push(it->path().string())) {
+            found++;
+        }
+    }
+    if (ec) cerr << "Unable to list folder: " << folderPath << " (" << ec.message() << ")" << endl;
+    paths.close();
+    return found;
+}
+
+/**
+ * Writes the puzzles of `puzzles` to `destination`. With a journal, the stream's state is
+ * checkpointed every JOURNAL_BATCH_SIZE puzzles and a matching journal is resumed from.
+ */
+static void createAndSaveNBoards(const int& num_puzzles, PuzzleStream& puzzles, const string& run_key, const string& destination,
+                                const string& prefix, const string& metrics_file, const string& journal_file){
+    Metrics metrics("create");
+    MetricSeries& generated = metrics.series("generate");
+    MetricSeries& written = metrics.series("write");
+
+    unique_ptr<ProgressJournal> journal;
+    if (!journal_file.empty()) {
+        journal.reset(new ProgressJournal(journal_file, run_key + " " + destination + " " + prefix));
+        if (journal->resumed() && puzzles.restoreState(journal->generatorState())) {
+            cout << "Resuming from " << journal_file << " at puzzle " << puzzles.produced() << endl;
+        } else {
+            journal->checkpoint(0, puzzles.saveState());
+        }
+    }
+    long long first = puzzles.produced();
+    StatusReporter status(metrics, written, num_puzzles - first);
+
+    for(;;){
+        auto start = steady_clock::now();
+        if (!puzzles.next()) break;
+        generated.record(nanosecondsSince(start));
+
+        start = steady_clock::now();
+        string filename = getShardedFileName(puzzles.produced() - 1, destination, prefix);
+        written.record(nanosecondsSince(start), writeSudokuToFile(puzzles.board(), filename));
+        if (journal && puzzles.produced() % JOURNAL_BATCH_SIZE == 0) {
+            journal->checkpoint(puzzles.produced(), puzzles.saveState());
+        }
+    }
+    status.stop();
+    if (journal) journal->finish();
+    cout << written.count - written.failures << " files written out of " << num_puzzles - first << endl;
+    if (!metrics_file.empty()) metrics.writeJson(metrics_file);
+}
+
+void createAndSaveNPuzzles(const int& num_puzzles, const int& complexity_empty_boxes, const string& destination, const string& prefix,
+                           const string& metrics_file, const string& journal_file){
+    PuzzleStream puzzles(complexity_empty_boxes, num_puzzles);
+    string run_key = "create " + to_string(num_puzzles) + " empty=" + to_string(complexity_empty_boxes);
+    createAndSaveNBoards(num_puzzles, puzzles, run_key, destination, prefix, metrics_file, journal_file);
+}
+
+void createAndSaveNMinimalPuzzles(const int& num_puzzles, const bool& symmetric, const string& destination, const string& prefix,
+                                  const string& metrics_file, const string& journal_file){
+    // Clue removals are tested on every core; the puzzles do not depend on the thread count
+    PuzzleStream puzzles(0, num_puzzles, 0, symmetric ? SYMMETRIC_MINIMAL : MINIMAL, max(1, (int) thread::hardware_concurrency()));
+    string run_key = "create " + to_string(num_puzzles) + (symmetric ? " symmetric-minimal" : " minimal");
+    createAndSaveNBoards(num_puzzles, puzzles, run_key, destination, prefix, metrics_file, journal_file);
+}
+
+void createAndSaveRatedPuzzles(const vector<int>& targets, const string& destination, const string& prefix, const string& ratings_file,
+                               const long long& max_attempts){
+    ofstream ratings(ratings_file);
+    if (!ratings.is_open()) {
+        cerr << "Unable to open file: " << ratings_file << ", no rated puzzles generated" << endl;
+        return;
+    }
+    ratings << "file,difficulty,naked_singles,hidden_singles,guesses,nodes,max_depth" << endl;
+
+    vector<RatedPuzzle> puzzles = generateRatedPuzzles(targets, 0, max_attempts);
+
     int total_success = 0;
-    for(int i=0; i < num_puzzles; i++){
-        int** BOARD = generateBoard(complexity_empty_boxes);
-        string filename = getFileName(i, destination, prefix);
-        if(writeSudokuToFile(BOARD, filename)){
+    vector<int> filled(NUM_DIFFICULTIES, 0);
+    for(size_t i = 0; i < puzzles.size(); i++){
+        const SolveEffort& effort = puzzles[i].effort;
+        filled[effort.difficulty]++;
+        string filename = getShardedFileName((int) i, destination, prefix);
+        if(writeSudokuToFile(puzzles[i].board, filename)){
             total_success++;
-            cout << "Successfully written(" << filename << ") "<< total_success << "of " << num_puzzles << endl;
-        }else{
-            cout << "!! Failed to write(" << filename << ") "<< total_success << "of " << num_puzzles << endl;
+            ratings << filename << "," << difficultyName(effort.difficulty) << "," << effort.nakedSingles << ","
+                    << effort.hiddenSingles << "," << effort.guesses << "," << effort.nodes << "," << effort.maxDepth << endl;
+        }
+        deallocateBoard(puzzles[i].board);
+    }
+    cout << total_success << " rated files written out of " << puzzles.size() << endl;
+    for (int d = 0; d < NUM_DIFFICULTIES && d < (int) targets.size(); d++) {
+        if (filled[d] < targets[d]) {
+            cout << "Bucket " << difficultyName((Difficulty) d) << " unfilled after " << max_attempts << " attempts: "
+                 << filled[d] << " of " << targets[d] << " puzzles" << endl;
         }
-        deallocateBoard(BOARD, i);
     }
-    cout << total_success << " files written out of " << num_puzzles <<endl;
 }
 
-void displayProgressBar(int current, int total, int barWidth = 50) {
-    float progress = static_cast<float>(current) / total;
-    int pos = static_cast<int>(barWidth * progress);
+/**
+ * A puzzle on its way from the reader thread through a solver worker to the writer thread.
+ */
+struct SolveTask {
+    string path;
+    int index = -1;
+    int** board = nullptr;   // nullptr if the file could not be read
+    bool solved = false;     // true if the board holds a valid solution to write
+};
+
+void solveAndSaveNPuzzles(const int &num_puzzles, const string& source, const string& destination, const string& prefix,
+                          const string& metrics_file, const int& num_threads, const ShardSpec& shard,
+                          const string& journal_file){
+    // Puzzles 0..num_puzzles-1 owned by this shard; a split by hash is only close to even
+    int expected = shard.count <= 1 ? num_puzzles
+                   : shard.by_hash ? num_puzzles / shard.count
+                   : (num_puzzles - shard.index + shard.count - 1) / shard.count;
+    Metrics metrics(shard.count <= 1 ? "solve" : "solve shard " + to_string(shard.index) + "/" + to_string(shard.count));
+    MetricSeries& read = metrics.series("read");
+    MetricSeries& solved = metrics.series("solve");
+    MetricSeries& validated = metrics.series("validate");
+    MetricSeries& written = metrics.series("write");
+
+    unique_ptr<ProgressJournal> journal;
+    // Output numbers of files without an index, and puzzles left for a resumed run to
+    // retry; only the writer thread uses them
+    int nextUnnamed = 0;
+    long long retry = 0;
+    if (!journal_file.empty()) {
+        string run_key = "solve " + to_string(num_puzzles) + " " + to_string(shard.index) + "/" + to_string(shard.count)
+                         + (shard.by_hash ? ":hash " : " ") + source + " " + destination + " " + prefix;
+        journal.reset(new ProgressJournal(getShardFileName(journal_file, shard), run_key));
+        if (journal->resumed()) {
+            cout << "Resuming from " << getShardFileName(journal_file, shard) << ": "
+                 << journal->completedOnStart() << " puzzles already solved" << endl;
+            nextUnnamed = (int) journal->outputOffset();
+        }
+    }
+    long long skipped = journal ? journal->completedOnStart() : 0;
+    StatusReporter status(metrics, solved, expected - skipped);
+
+    BoundedQueue<string> paths(1024);
+    long long found = 0;
+    thread lister([&]() { found = streamSudokuInFolder(source, paths); });
+
+    // The reader and writer threads move files in batches of IO_BATCH_SIZE, so file I/O
+    // overlaps with solving and costs a few system calls per batch instead of per file
+    BoundedQueue<SolveTask> boards(2 * IO_BATCH_SIZE);
+    BoundedQueue<SolveTask> finished(2 * IO_BATCH_SIZE);
+    string io_backend;
+    thread reader([&]() {
+        BatchFileIO io;
+        io_backend = io.backendName();
+        vector<FileJob> jobs;
+        vector<int> indices;
+        string path;
+        bool more = true;
+        while (more) {
+            jobs.clear();
+            indices.clear();
+            // Wait for one path, then take whatever else is already listed
+            while ((int) jobs.size() < IO_BATCH_SIZE && (jobs.empty() ? (more = paths.pop(path)) : paths.tryPop(path))) {
+                if (!isInShard(shard, path)) continue;
+                int index = getIndexFromFileName(path);
+                if (journal && (index >= 0 ? journal->isDone(index) : journal->isDone(path))) continue;
+                jobs.push_back(FileJob());
+                jobs.back().path = path;
+                indices.push_back(index);
+            }
+            if (jobs.empty()) continue;
+
+            auto start = steady_clock::now();
+            io.readFiles(jobs);
+            long long perFile = nanosecondsSince(start) / (long long) jobs.size();
+            for (size_t i = 0; i < jobs.size(); i++) {
+                read.record(perFile, jobs[i].ok);
+                SolveTask task;
+                task.path = jobs[i].path;
+                task.index = indices[i];
+                task.board = jobs[i].ok ? parseSudoku(jobs[i].data) : nullptr;
+                boards.push(task);
+            }
+        }
+        boards.close();
+    });
+
+    thread writer([&]() {
+        BatchFileIO io;
+        vector<FileJob> jobs;
+        vector<SolveTask> tasks;
+        vector<int> jobOf;       // index in jobs of each task's output, -1 if it writes nothing
+        SolveTask task;
+        bool more = true;
+        while (more) {
+            jobs.clear();
+            tasks.clear();
+            jobOf.clear();
+            int numbered = nextUnnamed;
+            while ((int) tasks.size() < IO_BATCH_SIZE && (tasks.empty() ? (more = finished.pop(task)) : finished.tryPop(task))) {
+                tasks.push_back(task);
+                jobOf.push_back(-1);
+                if (!task.solved) continue;
+                // Keep the puzzle's index; files without one are numbered after the corpus,
+                // interleaved by shard so shards never pick the same number
+                int output = task.index >= 0 ? task.index : num_puzzles + numbered++ * shard.count + shard.index;
+                jobOf.back() = (int) jobs.size();
+                jobs.push_back(FileJob());
+                jobs.back().path = getShardedFileName(output, destination, prefix);
+                boardToString(task.board, jobs.back().data);
+            }
+            if (tasks.empty()) continue;
+
+            if (!jobs.empty()) {
+                auto start = steady_clock::now();
+                io.writeFiles(jobs);
+                long long perFile = nanosecondsSince(start) / (long long) jobs.size();
+                for (const FileJob& job : jobs) {
+                    if (!job.ok) cerr << "Unable to open file: " << job.path << endl;
+                    written.record(perFile, job.ok);
+                }
+            }
 
-    cout << "\r[";
-    for (int i = 0; i < barWidth; ++i) {
-        if (i < pos) cout << "=";
-        else if (i == pos) cout << ">";
-        else cout << " ";
+            // A task is journaled once its result is final: its solution was written, or
+            // its board has no solution. Failed reads and writes stay pending so a resumed
+            // run retries them. nextUnnamed only counts numbers written without a gap:
+            // after a failed unnamed write the later unnamed outputs of the batch are not
+            // journaled either, so their inputs and the failed number are used again
+            bool gap = false;
+            for (size_t i = 0; i < tasks.size(); i++) {
+                SolveTask& done = tasks[i];
+                bool final = done.board != nullptr;
+                if (jobOf[i] >= 0) {
+                    final = jobs[jobOf[i]].ok;
+                    if (done.index < 0) {
+                        gap = gap || !final;
+                        final = !gap;
+                        if (final) nextUnnamed++;
+                    }
+                }
+                if (done.board) deallocateBoard(done.board);
+                if (!journal) continue;
+                if (!final) retry++;
+                else if (done.index >= 0) journal->markDone(done.index, nextUnnamed);
+                else journal->markDone(done.path, nextUnnamed);
+            }
+            // Without a journal nothing is retried, so a failed number is simply skipped
+            if (!journal) nextUnnamed = numbered;
+        }
+    });
+
+    int workers = num_threads > 0 ? num_threads : max(1, (int) thread::hardware_concurrency());
+    vector<thread> pool;
+    for (int w = 0; w < workers; w++) {
+        pool.emplace_back([&]() {
+            SolveTask task;
+            while (boards.pop(task)) {
+                bool ok = task.board != nullptr;
+                if(ok){
+                    auto start = steady_clock::now();
+                    ok = solve(task.board);
+                    solved.record(nanosecondsSince(start), ok);
+                }
+                if(ok){
+                    auto start = steady_clock::now();
+                    ok = checkIfSolutionIsValid(task.board);
+                    validated.record(nanosecondsSince(start), ok);
+                }
+                task.solved = ok;
+                finished.push(task);
+            }
+        });
     }
-    cout << "] " << setw(3) << int(progress * 100.0) << "%";
-    cout.flush();
+    lister.join();
+    reader.join();
+    for (thread& worker : pool) worker.join();
+    finished.close();
+    writer.join();
+    status.stop();
+
+    long long loaded = read.count;
+    long long total_success_solve = validated.count - validated.failures;
+    long long total_success_write = written.count - written.failures;
+    if (shard.count > 1) cout << "Shard " << shard.index << "/" << shard.count << " owns " << loaded << " of " << found << " listed puzzles" << endl;
+    cout << "Number of loaded puzzles:" << loaded << "/" << expected << endl;
+    cout << "Puzzle Solved(over available): " << total_success_solve << "/" << loaded << " | ";
+    cout << "Puzzle Solved(over total): " << total_success_solve << "/" << expected << endl;
+    cout << "Puzzle Solved Written(over available): " << total_success_write << "/" << loaded << " | ";
+    cout << "Puzzle Solved Written(over total): " << total_success_write << "/" << expected << endl;
+    cout << "File I/O: " << io_backend << " in batches of up to " << IO_BATCH_SIZE << " files" << endl;
+    if (journal) {
+        cout << "Skipped " << skipped << " puzzles solved by an earlier attempt" << endl;
+        if (retry == 0) {
+            journal->finish();
+        } else {
+            // Keep the journal: the next run with it retries only the puzzles that failed
+            journal->flush();
+            cout << retry << " puzzles could not be read or written; run again to retry them" << endl;
+        }
+    }
+    metrics.printSummary();
+    if (!metrics_file.empty()) metrics.writeJson(getShardFileName(metrics_file, shard));
 }
 
-void solveAndSaveNPuzzles(const int &num_puzzles, const string& source, const string& destination, const string& prefix){
-    int total_success_solve = 0;
-    int total_success_write = 0;
-    vector<string> path_to_sudokus = getAllSudokuInFolder(source);
-
-    cout << "Number of loaded puzzles:" << path_to_sudokus.size() << "/" << num_puzzles << endl;
-    for(int i = 0; i < path_to_sudokus.size(); i++){
-        int** sudoku = readSudokuFromFile(path_to_sudokus[i]);
-        if(solve(sudoku)){
-            if(checkIfSolutionIsValid(sudoku)){
-                total_success_solve++;
-                string filename = getFileName(i, destination, prefix);
-                cout << "Puzzle Solved(over available): " << total_success_solve << "/" << path_to_sudokus.size() << " | ";
-                cout << "Puzzle Solved(over total): " << total_success_solve << "/" << num_puzzles << endl;
-                if(writeSudokuToFile(sudoku, filename)){
-                    total_success_write++;
-                }
-                cout << "Puzzle Solved Written(over available): " << total_success_write << "/" << path_to_sudokus.size() << " | ";
-                cout << "Puzzle Solved Written(over total): " << total_success_write << "/" << num_puzzles << endl;
+bool mergeShardResults(const int& shard_count, const vector<string>& shard_folders, const string& destination,
+                       const string& metrics_file){
+    long long copied = 0, skipped = 0;
+    for (const string& folder : shard_folders) {
+        if (!filesystem::exists(folder)) {
+            cerr << "Shard output not found: " << folder << endl;
+            continue;
+        }
+        if (filesystem::exists(destination) && filesystem::equivalent(folder, destination)) continue;
+        for (const auto& entry : filesystem::recursive_directory_iterator(folder)) {
+            if (!entry.is_regular_file()) continue;
+            filesystem::path target = filesystem::path(destination) / filesystem::relative(entry.path(), folder);
+            filesystem::create_directories(target.parent_path());
+            // Shards own disjoint indices, so an existing file is the same solution
+            if (filesystem::exists(target)) {
+                skipped++;
+                continue;
             }
+            filesystem::copy_file(entry.path(), target);
+            copied++;
         }
     }
+    if (!shard_folders.empty()) cout << copied << " files merged into " << destination << " (" << skipped << " already present)" << endl;
+
+    if (metrics_file.empty()) return true;
+    Metrics metrics("solve (" + to_string(shard_count) + " shards)");
+    bool complete = true;
+    for (int k = 0; k < shard_count; k++) {
+        complete = metrics.mergeJson(getShardFileName(metrics_file, ShardSpec {k, shard_count, false})) && complete;
+    }
+    metrics.printSummary();
+    metrics.writeJson(metrics_file);
+    return complete;
 }
 
 int** deepCopyBoard(int** original) {
@@ -226,86 +528,306 @@ int** deepCopyBoard(int** original) {
     return newBoard;
 }
 
-void compareSudokuSolvers(const int& experiment_size, const int& empty_boxes) {
-    double totalTimeSolveBoard = 0.0;
-    double totalTimeEfficientSolveBoard = 0.0;
-
-    int validSolutionsSolveBoard = 0;
-    int validSolutionsEfficientSolveBoard = 0;
-
-    int** board1 = nullptr;
-    int** board2 = nullptr;
-    bool solved = false;
+void copyBoard(int** source, int** destination) {
+    for (int i = 0; i < 9; i++) {
+        for (int j = 0; j < 9; j++) {
+            destination[i][j] = source[i][j];
+        }
+    }
+}
 
-    cout << "Running Sudoku Solver Comparisons...\n";
+/**
+ * A solver taking part in compareSudokuSolvers().
+ */
+struct SolverEngine {
+    string name;
+    function<bool(int**)> run;
+};
+
+static vector<SolverEngine> getBenchmarkEngines() {
+    SearchOptions randomLuby;
+    randomLuby.order = RANDOM_ORDER;
+    randomLuby.restarts = LUBY_RESTARTS;
+
+    return {
+        {"solveBoard", [](int** board) { return solve(board, BASIC_SOLVER); }},
+        {"solveBoardEfficient", [](int** board) { return solve(board, EFFICIENT_SOLVER); }},
+        {"random+luby", [randomLuby](int** board) { return solveBoardWithOptions(board, randomLuby); }},
+        {"adaptive", [](int** board) { return solve(board, ADAPTIVE_SOLVER); }},
+        {"cdcl", [](int** board) { return solve(board, SAT_SOLVER); }},
+        // Other PolicySolver combinations (see solver_policies.h)
+        {"mrv+singles", PolicySolver<MrvCell, AscendingValues, SinglesPropagation>::solve},
+        {"mrv+full", PolicySolver<MrvCell, AscendingValues, FullPropagation>::solve},
+        {"mrv+lcv+full", PolicySolver<MrvCell, LeastConstrainingValues, FullPropagation>::solve},
+    };
+}
 
-    for (int i = 1; i <= experiment_size; ++i) {
-        // Generate a single board and deep copy
-        board1 = generateBoard(empty_boxes);  // Fresh board for efficient solver
-        if (!board1) {
-            cerr << "Failed to generate board.\n";
-            continue;
-        }
-        board2 = deepCopyBoard(board1);       // Deep copy for regular solver
+/**
+ * Checks a solved board of any size, like checkIfSolutionIsValid(), and that it keeps the puzzle's clues.
+ */
+static bool checkIfSizedSolutionIsValid(const int* puzzle, const int* cells, const int& box_size) {
+    const int n = box_size * box_size;
+    vector<unsigned> rows(n), cols(n), boxes(n);
+    for (int i = 0; i < n * n; i++) {
+        if (cells[i] < 1 || cells[i] > n || (puzzle[i] != 0 && puzzle[i] != cells[i])) return false;
+        unsigned bit = 1u << (cells[i] - 1);
+        int r = i / n, c = i % n, b = box_size * (r / box_size) + c / box_size;
+        if ((rows[r] | cols[c] | boxes[b]) & bit) return false;
+        rows[r] |= bit; cols[c] |= bit; boxes[b] |= bit;
+    }
+    return true;
+}
 
-        // -------------------- Testing solveBoardEfficient --------------------
-        auto startEfficient = high_resolution_clock::now();
-        solved = solve(board1, true);  // Solve using efficient solver
+void compareLargeSudokuSolvers(const int& box_size, const int& experiment_size, const int& empty_cells,
+                               const long long& node_limit, const string& metrics_file) {
+    const int n = box_size * box_size;
+    Metrics metrics("compare(" + to_string(n) + "x" + to_string(n) + ", empty_cells=" + to_string(empty_cells) + ")");
+    MetricSeries& backtracking = metrics.series("mrv");
+    MetricSeries& cdcl = metrics.series("cdcl");
+
+    auto start = steady_clock::now();
+    SudokuSat sat(box_size);
+    double encodeMs = nanosecondsSince(start) / 1e6;
+
+    mt19937 generator(box_size * 7919 + empty_cells);
+    vector<int> puzzle((size_t) n * n), cells((size_t) n * n);
+    long long totalNodes = 0;
+    cout << "Running " << n << "x" << n << " Sudoku Solver Comparisons...\n";
+    StatusReporter status(metrics, cdcl, experiment_size);
+    for (int e = 0; e < experiment_size; e++) {
+        generateBoardOfSize(puzzle.data(), box_size, empty_cells, generator);
+
+        cells = puzzle;
+        long long nodes = 0;
+        start = steady_clock::now();
+        bool solved = solveBoardOfSize(cells.data(), box_size, node_limit, &nodes);
+        backtracking.record(nanosecondsSince(start), solved && checkIfSizedSolutionIsValid(puzzle.data(), cells.data(), box_size));
+        totalNodes += nodes;
+
+        cells = puzzle;
+        start = steady_clock::now();
+        solved = sat.solve(cells.data());
+        cdcl.record(nanosecondsSince(start), solved && checkIfSizedSolutionIsValid(puzzle.data(), cells.data(), box_size));
+    }
+    status.stop();
+
+    const SatStats& stats = sat.stats();
+    cout << "====================== Performance Summary (" << n << "x" << n << ", Empty Cells: " << empty_cells
+         << ") ======================" << endl;
+    cout << "Total Experiments: " << experiment_size << " | CDCL encoding built once in " << fixed << setprecision(2)
+         << encodeMs << " ms" << endl;
+    for (MetricSeries* result : {&backtracking, &cdcl}) {
+        cout << "-------------------------------------------------------------" << endl;
+        cout << result->name << " average time: " << setprecision(4) << result->latency.mean() / 1e6 << " milliseconds" << endl;
+        cout << result->name << " p50/p99/max: " << result->latency.percentile(0.5) / 1e6 << " / "
+             << result->latency.percentile(0.99) / 1e6 << " / " << result->latency.max() / 1e6 << " milliseconds" << endl;
+        cout << result->name << " valid solutions: " << result->count - result->failures << "/" << experiment_size << endl;
+    }
+    cout << "-------------------------------------------------------------" << endl;
+    cout << "mrv search nodes: " << totalNodes << " (limit " << node_limit << " per puzzle)" << endl;
+    cout << "cdcl decisions/conflicts/learned: " << stats.decisions << " / " << stats.conflicts << " / " << stats.learned << endl;
+    cout << "===========================================================================" << endl;
+    if (!metrics_file.empty()) metrics.writeJson(metrics_file);
+}
 
-        auto endEfficient = high_resolution_clock::now();
+/**
+ * Time of one solveAdaptive() call on a copy of `puzzle`, with the given thresholds in force.
+ */
+static long long timeAdaptive(int** puzzle, int** board, const DispatchThresholds& thresholds, DispatchDecision& decision) {
+    setDispatchThresholds(thresholds);
+    copyBoard(puzzle, board);
+    auto start = steady_clock::now();
+    solveAdaptive(board, &decision);
+    return nanosecondsSince(start);
+}
 
-        double elapsedEfficient = duration<double>(endEfficient - startEfficient).count();
-        totalTimeEfficientSolveBoard += elapsedEfficient;
+DispatchThresholds calibrateSolverDispatch(const int& experiment_size) {
+    const DispatchThresholds previous = getDispatchThresholds();
+    if (experiment_size <= 0) return previous;
+    DispatchThresholds sequentialOnly = previous, restartOnly = previous;
+    sequentialOnly.sequential_max_empty = 81;
+    sequentialOnly.sequential_max_density = 9.0;
+    restartOnly.sequential_max_empty = -1;
+
+    // Puzzles are bucketed by the empty cells left after naked singles, the count
+    // solveAdaptive() compares with sequential_max_empty
+    const int bucketWidth = 5, buckets = 81 / bucketWidth + 1;
+    vector<double> sequential(buckets, 0), restart(buckets, 0);
+    vector<int> counts(buckets, 0);
+    int** board = getEmptyBoard();
+    DispatchDecision decision;
+
+    cout << "Calibrating solver dispatch..." << endl;
+    for (int empty_boxes = 20; empty_boxes <= 64; empty_boxes += 4) {
+        for (int** puzzle : PuzzleStream(empty_boxes, experiment_size, empty_boxes)) {
+            long long sequentialTime = timeAdaptive(puzzle, board, sequentialOnly, decision);
+            if (decision.propagated) continue;
+            long long restartTime = timeAdaptive(puzzle, board, restartOnly, decision);
+            int bucket = decision.empty / bucketWidth;
+            sequential[bucket] += sequentialTime;
+            restart[bucket] += restartTime;
+            counts[bucket]++;
+        }
+    }
+    deallocateBoard(board);
+    setDispatchThresholds(previous);
+
+    DispatchThresholds calibrated = previous;
+    calibrated.sequential_max_empty = 0;
+    bool sequentialAhead = true;
+    cout << setw(20) << "Empty after singles" << setw(9) << "Puzzles" << setw(18) << "sequential(ms)" << setw(15) << "restart(ms)" << endl;
+    for (int bucket = 0; bucket < buckets; bucket++) {
+        if (counts[bucket] == 0) continue;
+        double sequentialMean = sequential[bucket] / counts[bucket], restartMean = restart[bucket] / counts[bucket];
+        cout << setw(14) << bucket * bucketWidth << "-" << setw(5) << left << bucket * bucketWidth + bucketWidth - 1 << right
+             << setw(9) << counts[bucket] << fixed << setprecision(4)
+             << setw(18) << sequentialMean / 1e6 << setw(15) << restartMean / 1e6 << endl;
+
+        // Stop at the first bucket where the row-by-row search falls behind
+        sequentialAhead = sequentialAhead && sequentialMean <= restartMean;
+        if (sequentialAhead) calibrated.sequential_max_empty = bucket * bucketWidth + bucketWidth - 1;
+    }
+    // Ahead in every bucket measured: no count is known where the restart solver is better
+    if (sequentialAhead) calibrated.sequential_max_empty = 81;
+    cout << "Row-by-row search up to " << calibrated.sequential_max_empty << " empty cells after naked singles" << endl;
+    return calibrated;
+}
 
-        // Validate solution
-        if (solved && checkIfSolutionIsValid(board1)) {
-            validSolutionsEfficientSolveBoard++;
-            deallocateBoard(board1);
-            board1 = nullptr;
-        } else {
-            cerr << "solveBoardEfficient produced an invalid solution.\n";
+void measureSessionMemory(const int& max_sessions, const int& steps) {
+    vector<int**> puzzles;
+    for (int** puzzle : PuzzleStream(45, 64, 45)) puzzles.push_back(deepCopyBoard(puzzle));
+
+    cout << "Measuring session memory (" << SESSION_BYTES << " bytes per session)..." << endl;
+    cout << setw(10) << "Sessions" << setw(14) << "RSS grow(MB)" << setw(16) << "Bytes/session" << setw(14) << "Hint(us)" << endl;
+    double worstDeviation = 0;
+    bool measured = true;
+    for (int step = 1; step <= steps; step++) {
+        long long count = (long long) max_sessions * step / steps;
+        long long before = residentSetBytes();
+        vector<SudokuSession> sessions;
+        sessions.reserve(count);
+        for (long long i = 0; i < count; i++) sessions.emplace_back(puzzles[i % puzzles.size()]);
+
+        // Touch every session's search and edit paths, as live hint traffic would
+        auto start = steady_clock::now();
+        for (SudokuSession& session : sessions) {
+            CellMove move;
+            if (session.hint(move)) session.set(move.row, move.col, move.value);
         }
+        double hintUs = count > 0 ? nanosecondsSince(start) / 1e3 / count : 0;
+        long long after = residentSetBytes();
+
+        measured = measured && before >= 0 && after >= 0;
+        double perSession = measured && count > 0 ? (double) (after - before) / count : 0;
+        if (measured) worstDeviation = max(worstDeviation, abs(perSession - SESSION_BYTES) / SESSION_BYTES);
+        cout << setw(10) << count << fixed << setprecision(1) << setw(14) << (after - before) / 1048576.0
+             << setw(16) << perSession << setprecision(3) << setw(14) << hintUs << endl;
+    }
+    for (int** puzzle : puzzles) deallocateBoard(puzzle);
 
-        // -------------------- Testing solveBoard --------------------
-        auto startSolve = high_resolution_clock::now();
-        solved = solve(board2);  // Solve using basic solver
+    if (measured) cout << "Largest deviation from " << SESSION_BYTES << " bytes per session: " << setprecision(1) << 100 * worstDeviation << "%" << endl;
+    else cout << "Resident set size unavailable on this platform" << endl;
+}
 
-        auto endSolve = high_resolution_clock::now();
+/**
+ * Prints mean latency and, where counted, mean hardware counts per solve for every
+ * solver and difficulty band.
+ */
+static void printBandSummary(const vector<vector<MetricSeries*>>& banded, const PerfCounters* counters) {
+    bool counted = counters && counters->available();
+    cout << "-------------------- Per difficulty band --------------------" << endl;
+    if (!counters) cout << "Hardware counters: off" << endl;
+    else if (!counted) cout << "Hardware counters unavailable (" << counters->unavailableReason() << ")" << endl;
+    cout << setw(26) << "Solver/band" << setw(8) << "Count" << setw(11) << "Mean(ms)";
+    if (counted) {
+        cout << setw(12) << "Cycles" << setw(12) << "Instr" << setw(6) << "IPC"
+             << setw(10) << "BrMiss" << setw(10) << "L1DMiss" << setw(10) << "LLCMiss";
+    }
+    cout << endl;
+    for (const vector<MetricSeries*>& bands : banded) {
+        for (const MetricSeries* band : bands) {
+            if (!band) continue;
+            cout << setw(26) << band->name << setw(8) << band->count.load() << fixed << setprecision(4)
+                 << setw(11) << band->latency.mean() / 1e6 << setprecision(0);
+            if (counted) {
+                for (PerfEvent event : {PERF_CYCLES, PERF_INSTRUCTIONS}) {
+                    double mean = band->perfMean(event);
+                    if (mean < 0) cout << setw(12) << "-";
+                    else cout << setw(12) << mean;
+                }
+                double cycles = band->perfMean(PERF_CYCLES), instructions = band->perfMean(PERF_INSTRUCTIONS);
+                if (cycles > 0 && instructions >= 0) cout << setprecision(2) << setw(6) << instructions / cycles << setprecision(0);
+                else cout << setw(6) << "-";
+                for (PerfEvent event : {PERF_BRANCH_MISSES, PERF_L1D_MISSES, PERF_LLC_MISSES}) {
+                    double mean = band->perfMean(event);
+                    if (mean < 0) cout << setw(10) << "-";
+                    else cout << setw(10) << mean;
+                }
+            }
+            cout << endl;
+        }
+    }
+}
 
-        double elapsedSolve = duration<double>(endSolve - startSolve).count();
-        totalTimeSolveBoard += elapsedSolve;
+void compareSudokuSolvers(const int& experiment_size, const int& empty_boxes, const string& metrics_file,
+                          const bool& hardware_counters) {
+    Metrics metrics("compare(empty_boxes=" + to_string(empty_boxes) + ")");
+    vector<SolverEngine> engines = getBenchmarkEngines();
+    vector<MetricSeries*> series;
+    for (const SolverEngine& engine : engines) {
+        series.push_back(&metrics.series(engine.name));
+    }
+    // Series per solver and difficulty band, created when the band first shows up
+    vector<vector<MetricSeries*>> banded(engines.size(), vector<MetricSeries*>(NUM_DIFFICULTIES, nullptr));
+    unique_ptr<PerfCounters> counters;
+    if (hardware_counters) counters.reset(new PerfCounters());
 
+    // Puzzles are pulled lazily and copied into one reused board per solver
+    PuzzleStream puzzles(empty_boxes, experiment_size);
+    int** board = getEmptyBoard();
 
-        // Validate solution
-        if (solved && checkIfSolutionIsValid(board2)) {
-            validSolutionsSolveBoard++;
-            deallocateBoard(board2);
-            board2 = nullptr;
-        } else {
-            cerr << "solveBoard produced an invalid solution.\n";
+    cout << "Running Sudoku Solver Comparisons...\n";
+    StatusReporter status(metrics, *series[0], experiment_size);
+
+    for (int** puzzle : puzzles) {
+        Difficulty band = rateBoard(puzzle).difficulty;
+        for (size_t e = 0; e < engines.size(); e++) {
+            copyBoard(puzzle, board);
+
+            // The counters are started and read outside the timed region
+            PerfSample sample;
+            if (counters) counters->start();
+            auto start = steady_clock::now();
+            bool solved = engines[e].run(board);
+            long long elapsed = nanosecondsSince(start);
+            if (counters) counters->stop(sample);
+
+            // Validate solution
+            bool ok = solved && checkIfSolutionIsValid(board);
+            MetricSeries*& bandSeries = banded[e][band];
+            if (!bandSeries) bandSeries = &metrics.series(engines[e].name + "/" + difficultyName(band));
+            series[e]->record(elapsed, ok);
+            series[e]->recordPerf(sample);
+            bandSeries->record(elapsed, ok);
+            bandSeries->recordPerf(sample);
         }
-
-        // -------------------- Progress Bar Update --------------------
-        displayProgressBar(i, experiment_size);
     }
-
-    cout << endl;  // Move to the next line after progress bar is done.
+    status.stop();
+    deallocateBoard(board);
 
     // -------------------- Summary --------------------
     cout << "====================== Performance Summary (Empty Boxes: " << empty_boxes << ") ======================" << endl;
     cout << "Total Experiments: " << experiment_size << endl;
-    cout << "-------------------------------------------------------------" << endl;
-
-    cout << "solveBoard average time: " << fixed << setprecision(4)
-         << 1000 * (totalTimeSolveBoard / experiment_size) << " milliseconds" << endl;
-    cout << "solveBoard valid solutions: " << validSolutionsSolveBoard << "/" << experiment_size << endl;
-
-    cout << "-------------------------------------------------------------" << endl;
-
-    cout << "efficientSolveBoard average time: " << fixed << setprecision(4)
-         << 1000 * (totalTimeEfficientSolveBoard / experiment_size) << " milliseconds" << endl;
-    cout << "efficientSolveBoard valid solutions: " << validSolutionsEfficientSolveBoard << "/" << experiment_size << endl;
-
+    for (MetricSeries* result : series) {
+        cout << "-------------------------------------------------------------" << endl;
+        cout << result->name << " average time: " << fixed << setprecision(4)
+             << result->latency.mean() / 1e6 << " milliseconds" << endl;
+        cout << result->name << " p50/p99/p999: " << result->latency.percentile(0.5) / 1e6 << " / "
+             << result->latency.percentile(0.99) / 1e6 << " / " << result->latency.percentile(0.999) / 1e6
+             << " milliseconds" << endl;
+        cout << result->name << " valid solutions: " << result->count - result->failures << "/" << experiment_size << endl;
+    }
+    printBandSummary(banded, counters.get());
     cout << "===========================================================================" << endl;
+    if (!metrics_file.empty()) metrics.writeJson(metrics_file);
 }
-
@@ -4,6 +4,12 @@
 #include <iostream>
 #include <string>
 #include <filesystem>
+#include <cctype>
+#include <fstream>
+#include "../include/utils.h"
+#ifdef __linux__
+#include <unistd.h>
+#endif
 using namespace std;
 
 void deallocateBoard(int** BOARD, const int& rows) {
@@ -34,9 +40,86 @@ void initDataFolder(){
     createFolder("data/solutions/");
 }
 
-string getFileName(const int& index, const string& destination, const string& prefix){
+static string padIndex(const int& index){
     string index_str = to_string(index);
-    string index_fill = string(4 - index_str.length(), '0');
-    string filename = destination + index_fill + index_str + prefix + ".txt";
+    if (index_str.length() >= 4) return index_str;
+    return string(4 - index_str.length(), '0') + index_str;
+}
+
+string getFileName(const int& index, const string& destination, const string& prefix){
+    string filename = destination + padIndex(index) + prefix + ".txt";
     return filename;
-}
\ No newline at end of file
+}
+
+string getShardedFileName(const int& index, const string& destination, const string& prefix){
+    return getFileName(index, destination + padIndex(index / FILES_PER_SHARD) + "/", prefix);
+}
+
+bool parseShardSpec(const string& text, ShardSpec& shard){
+    ShardSpec parsed;
+    string spec = text;
+    const string hashSuffix = ":hash";
+    if (spec.size() > hashSuffix.size() && spec.compare(spec.size() - hashSuffix.size(), hashSuffix.size(), hashSuffix) == 0) {
+        parsed.by_hash = true;
+        spec.erase(spec.size() - hashSuffix.size());
+    }
+    size_t slash = spec.find('/');
+    if (slash == string::npos || slash == 0 || slash + 1 == spec.size()) return false;
+    for (size_t i = 0; i < spec.size(); i++) {
+        if (i != slash && !isdigit((unsigned char) spec[i])) return false;
+    }
+    if (slash > 9 || spec.size() - slash - 1 > 9) return false;
+    parsed.index = stoi(spec.substr(0, slash));
+    parsed.count = stoi(spec.substr(slash + 1));
+    if (parsed.count < 1 || parsed.index >= parsed.count) return false;
+    shard = parsed;
+    return true;
+}
+
+/**
+ * FNV-1a hash of a file name, used when puzzles are split by hash.
+ */
+static unsigned long long hashFileName(const string& name){
+    unsigned long long hash = 14695981039346656037ULL;
+    for (unsigned char ch : name) {
+        hash ^= ch;
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+bool isInShard(const ShardSpec& shard, const string& path){
+    if (shard.count <= 1) return true;
+    int index = shard.by_hash ? -1 : getIndexFromFileName(path);
+    if (index >= 0) return index % shard.count == shard.index;
+    return hashFileName(filesystem::path(path).filename().string()) % shard.count == (unsigned long long) shard.index;
+}
+
+string getShardFileName(const string& filename, const ShardSpec& shard){
+    if (shard.count <= 1) return filename;
+    string tag = ".shard-" + to_string(shard.index) + "-of-" + to_string(shard.count);
+    size_t slash = filename.find_last_of('/');
+    size_t dot = filename.find_last_of('.');
+    if (dot == string::npos || (slash != string::npos && dot < slash)) return filename + tag;
+    return filename.substr(0, dot) + tag + filename.substr(dot);
+}
+
+int getIndexFromFileName(const string& path){
+    string name = filesystem::path(path).filename().string();
+    size_t digits = 0;
+    while (digits < name.size() && isdigit((unsigned char) name[digits])) digits++;
+    if (digits == 0 || digits > 9) return -1;
+    return stoi(name.substr(0, digits));
+}
+
+long long residentSetBytes(){
+#ifdef __linux__
+    // Fields are in pages: total program size, then resident size
+    ifstream statm("/proc/self/statm");
+    long long size = 0, resident = 0;
+    if (!(statm >> size >> resident)) return -1;
+    return resident * sysconf(_SC_PAGESIZE);
+#else
+    return -1;
+#endif
+}
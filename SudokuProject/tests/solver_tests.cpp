@@ -0,0 +1,295 @@
+/**
+ * @file solver_tests.cpp
+ * @brief Cross-checks of every solver engine, run by ctest.
+ *
+ * Solves a fixed-seed PuzzleStream with every engine and checks that each answer is a
+ * valid solution that keeps the clues, and that engines agree on puzzles with a unique
+ * solution. Checks that boards without a solution and boards with clashing clues are
+ * left unchanged, that solution enumeration reports none for clashing clues, and the
+ * status codes of sudoku_solve() and sudoku_solve_batch().
+ * Prints every failed check and exits with 1 if there was one.
+ *
+ * @date
+ * October 19, 2026
+ */
+
+#include "../include/generator.h"
+#include "../include/solver_policies.h"
+#include "../include/sudoku.h"
+#include "../include/sudoku_api.h"
+#include "../include/sudoku_c.h"
+#include "../include/sudoku_io.h"
+#include "../include/utils.h"
+#include <functional>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+static int failures = 0;
+
+#define CHECK(condition, what) \
+    do { \
+        if (!(condition)) { \
+            failures++; \
+            cerr << __FILE__ << ":" << __LINE__ << ": " << (what) << endl; \
+        } \
+    } while (0)
+
+/**
+ * An engine under test: solves a row-major board of 81 cells in place.
+ */
+struct TestedEngine {
+    string name;
+    function<bool(int* cells)> solve;
+};
+
+/**
+ * Runs `solver` on an int** copy of `cells` and copies the board back.
+ */
+static bool onBoard(int* cells, const function<bool(int**)>& solver) {
+    int** board = getEmptyBoard();
+    for (int i = 0; i < 81; i++) board[i / 9][i % 9] = cells[i];
+    bool solved = solver(board);
+    for (int i = 0; i < 81; i++) cells[i] = board[i / 9][i % 9];
+    deallocateBoard(board);
+    return solved;
+}
+
+static vector<TestedEngine> engines() {
+    vector<TestedEngine> list;
+    const pair<const char*, SolverKind> kinds[] = {
+        {"solve(BASIC_SOLVER)", BASIC_SOLVER}, {"solve(EFFICIENT_SOLVER)", EFFICIENT_SOLVER},
+        {"solve(RESTART_SOLVER)", RESTART_SOLVER}, {"solve(ADAPTIVE_SOLVER)", ADAPTIVE_SOLVER},
+        {"solve(SAT_SOLVER)", SAT_SOLVER}};
+    for (const auto& kind : kinds) {
+        SolverKind k = kind.second;
+        list.push_back({kind.first, [k](int* cells) { return onBoard(cells, [k](int** b) { return solve(b, k); }); }});
+    }
+    list.push_back({"SequentialSolver", [](int* cells) { return onBoard(cells, SequentialSolver::solve); }});
+    list.push_back({"MrvSolver", [](int* cells) { return onBoard(cells, MrvSolver::solve); }});
+    list.push_back({"PolicySolver<SequentialCell, AscendingValues, SinglesPropagation>", [](int* cells) {
+        return onBoard(cells, PolicySolver<SequentialCell, AscendingValues, SinglesPropagation>::solve);
+    }});
+    list.push_back({"PolicySolver<MrvCell, LeastConstrainingValues, FullPropagation>", [](int* cells) {
+        return onBoard(cells, PolicySolver<MrvCell, LeastConstrainingValues, FullPropagation>::solve);
+    }});
+    list.push_back({"solveBoardOfSize(3)", [](int* cells) { return solveBoardOfSize(cells, 3); }});
+    const pair<const char*, sudoku::Engine> apiEngines[] = {
+        {"sudoku::solve(Basic)", sudoku::Engine::Basic}, {"sudoku::solve(Efficient)", sudoku::Engine::Efficient},
+        {"sudoku::solve(Restart)", sudoku::Engine::Restart}, {"sudoku::solve(Adaptive)", sudoku::Engine::Adaptive},
+        {"sudoku::solve(Sat)", sudoku::Engine::Sat}};
+    for (const auto& engine : apiEngines) {
+        sudoku::Engine e = engine.second;
+        list.push_back({engine.first, [e](int* cells) { return sudoku::solve(cells, e) == sudoku::Status::Solved; }});
+    }
+    return list;
+}
+
+static vector<int> toCells(int** board) {
+    vector<int> cells(81);
+    for (int i = 0; i < 81; i++) cells[i] = board[i / 9][i % 9];
+    return cells;
+}
+
+static bool keepsClues(const vector<int>& puzzle, const vector<int>& solution) {
+    for (int i = 0; i < 81; i++) {
+        if (puzzle[i] != 0 && puzzle[i] != solution[i]) return false;
+    }
+    return true;
+}
+
+/**
+ * Every engine solves every puzzle of the stream with a valid solution that keeps the
+ * clues; on puzzles with a unique solution every engine returns the same one.
+ */
+static void testEnginesAgree(PuzzleStream& stream, const bool& unique, const string& label) {
+    vector<TestedEngine> list = engines();
+    int index = 0;
+    for (int** puzzle : stream) {
+        vector<int> clues = toCells(puzzle);
+        vector<int> expected;
+        for (const TestedEngine& engine : list) {
+            vector<int> cells = clues;
+            string where = label + " #" + to_string(index) + ", " + engine.name;
+            CHECK(engine.solve(cells.data()), where + ": not solved");
+            CHECK(sudoku::isValidSolution(cells.data()), where + ": invalid solution");
+            CHECK(keepsClues(clues, cells), where + ": clues changed");
+            if (!unique) continue;
+            if (expected.empty()) expected = cells;
+            CHECK(cells == expected, where + ": differs from " + list[0].name);
+        }
+        index++;
+    }
+}
+
+/**
+ * Fills one empty cell of a puzzle with a unique solution with a digit that clashes with
+ * no clue but differs from the solution, so the board has no solution.
+ */
+static vector<int> unsolvableFrom(int** puzzle) {
+    vector<int> clues = toCells(puzzle);
+    vector<int> solution = clues;
+    sudoku::solve(solution.data());
+    for (int i = 0; i < 81; i++) {
+        if (clues[i] != 0) continue;
+        for (int k = 1; k <= 9; k++) {
+            if (k == solution[i]) continue;
+            clues[i] = k;
+            if (sudoku::hasValidClues(clues.data())) return clues;
+        }
+        clues[i] = 0;
+    }
+    return vector<int>();
+}
+
+/**
+ * Boards without a solution and boards with clashing clues are reported unsolved and
+ * left unchanged by every engine.
+ */
+static void testRejectedBoardsUnchanged() {
+    vector<vector<int>> boards;
+    for (int** puzzle : PuzzleStream(0, 4, 41, MINIMAL)) {
+        vector<int> board = unsolvableFrom(puzzle);
+        CHECK(!board.empty(), "no unsolvable board derived from a minimal puzzle");
+        if (!board.empty()) boards.push_back(board);
+    }
+    for (int** puzzle : PuzzleStream(45, 4, 42)) {
+        vector<int> board = toCells(puzzle);
+        int empty = 0;
+        while (board[empty] != 0) empty++;
+        // Repeat a clue of the same row in an empty cell
+        for (int c = 0; c < 9; c++) {
+            if (board[empty / 9 * 9 + c] != 0) {
+                board[empty] = board[empty / 9 * 9 + c];
+                break;
+            }
+        }
+        boards.push_back(board);
+    }
+
+    for (const TestedEngine& engine : engines()) {
+        for (size_t i = 0; i < boards.size(); i++) {
+            vector<int> cells = boards[i];
+            string where = "rejected board #" + to_string(i) + ", " + engine.name;
+            CHECK(!engine.solve(cells.data()), where + ": reported solved");
+            CHECK(cells == boards[i], where + ": board changed");
+        }
+    }
+}
+
+/**
+ * Status codes of the C API for solvable, unsolvable and invalid boards and unknown engines.
+ */
+static void testCStatusCodes() {
+    PuzzleStream stream(0, 1, 43, MINIMAL);
+    stream.next();
+    vector<int> solvable = toCells(stream.board());
+    vector<int> unsolvable = unsolvableFrom(stream.board());
+    vector<int> clashing = solvable, outOfRange = solvable;
+    int empty = 0;
+    while (solvable[empty] != 0) empty++;
+    for (int i = 0; i < 81; i++) {
+        if (solvable[i] != 0 && i / 9 == empty / 9) clashing[empty] = solvable[i];
+    }
+    outOfRange[empty] = 10;
+
+    const sudoku_engine all[] = {SUDOKU_ENGINE_BASIC, SUDOKU_ENGINE_EFFICIENT, SUDOKU_ENGINE_RESTART,
+                                 SUDOKU_ENGINE_ADAPTIVE, SUDOKU_ENGINE_SAT};
+    for (sudoku_engine engine : all) {
+        string where = "sudoku_solve(engine " + to_string((int) engine) + ")";
+        vector<int> cells = solvable;
+        CHECK(sudoku_solve(cells.data(), engine) == SUDOKU_SOLVED, where + ": solvable board");
+        CHECK(sudoku_is_valid_solution(cells.data()) && keepsClues(solvable, cells), where + ": wrong solution");
+
+        cells = unsolvable;
+        CHECK(sudoku_solve(cells.data(), engine) == SUDOKU_NO_SOLUTION, where + ": unsolvable board");
+        CHECK(cells == unsolvable, where + ": unsolvable board changed");
+
+        for (const vector<int>& invalid : {clashing, outOfRange}) {
+            cells = invalid;
+            CHECK(sudoku_solve(cells.data(), engine) == SUDOKU_INVALID_INPUT, where + ": invalid board");
+            CHECK(cells == invalid, where + ": invalid board changed");
+        }
+    }
+
+    vector<int> cells = solvable;
+    CHECK(sudoku_solve(cells.data(), (sudoku_engine) 42) == SUDOKU_INVALID_INPUT, "sudoku_solve: unknown engine");
+    CHECK(cells == solvable, "sudoku_solve: board changed by an unknown engine");
+
+    // One batch holding each kind of board
+    vector<int> batch;
+    for (const vector<int>* board : {&solvable, &unsolvable, &clashing, &outOfRange, &solvable}) {
+        batch.insert(batch.end(), board->begin(), board->end());
+    }
+    const sudoku_status expected[] = {SUDOKU_SOLVED, SUDOKU_NO_SOLUTION, SUDOKU_INVALID_INPUT,
+                                      SUDOKU_INVALID_INPUT, SUDOKU_SOLVED};
+    sudoku_status statuses[5];
+    CHECK(sudoku_solve_batch(batch.data(), 5, SUDOKU_ENGINE_ADAPTIVE, statuses) == 2, "sudoku_solve_batch: solved count");
+    for (int i = 0; i < 5; i++) {
+        CHECK(statuses[i] == expected[i], "sudoku_solve_batch: status of board " + to_string(i));
+    }
+    CHECK(vector<int>(batch.begin() + 81, batch.begin() + 162) == unsolvable, "sudoku_solve_batch: unsolvable board changed");
+
+    batch.assign(solvable.begin(), solvable.end());
+    CHECK(sudoku_solve_batch(batch.data(), 1, (sudoku_engine) 42, statuses) == 0, "sudoku_solve_batch: unknown engine solved");
+    CHECK(statuses[0] == SUDOKU_INVALID_INPUT, "sudoku_solve_batch: unknown engine status");
+    CHECK(sudoku_solve_batch(nullptr, 0, SUDOKU_ENGINE_ADAPTIVE, nullptr) == 0, "sudoku_solve_batch: empty batch");
+}
+
+/**
+ * enumerateSolutions() and enumerateSolutionsParallel() report no solution, and never call
+ * the callback, for boards whose clues clash, like countSolutions(); a minimal puzzle has
+ * exactly one.
+ */
+static void testEnumerationRejectsClashes() {
+    PuzzleStream stream(0, 1, 44, MINIMAL);
+    stream.next();
+    vector<int> minimal = toCells(stream.board());
+    vector<int> clashing = minimal;
+    int empty = 0;
+    while (clashing[empty] != 0) empty++;
+    for (int c = 0; c < 9; c++) {
+        if (minimal[empty / 9 * 9 + c] != 0) clashing[empty] = minimal[empty / 9 * 9 + c];
+    }
+    // Full board with every row 1..9: rows are fine, columns and boxes clash
+    vector<int> fullInvalid(81);
+    for (int i = 0; i < 81; i++) fullInvalid[i] = i % 9 + 1;
+
+    const pair<string, vector<int>> cases[] = {{"minimal", minimal}, {"clashing", clashing}, {"full invalid", fullInvalid}};
+    for (const auto& test : cases) {
+        long long expected = test.first == "minimal" ? 1 : 0;
+        int** board = getEmptyBoard();
+        for (int i = 0; i < 81; i++) board[i / 9][i % 9] = test.second[i];
+        long long calls = 0;
+        auto count = [&](int** solved) {
+            calls++;
+            CHECK(sudoku::isValidSolution(toCells(solved).data()), test.first + ": invalid board passed to the callback");
+            return true;
+        };
+        CHECK(enumerateSolutions(board, count) == expected, test.first + ": enumerateSolutions() count");
+        CHECK(enumerateSolutionsParallel(board, count, 0, 2) == expected, test.first + ": enumerateSolutionsParallel() count");
+        CHECK(calls == 2 * expected, test.first + ": callback calls");
+        CHECK(countSolutions(board) == expected, test.first + ": countSolutions()");
+        CHECK(toCells(board) == test.second, test.first + ": board changed");
+        deallocateBoard(board);
+    }
+}
+
+int main() {
+    PuzzleStream random(50, 30, 2026);
+    testEnginesAgree(random, false, "random removal");
+    PuzzleStream minimal(0, 10, 2027, MINIMAL);
+    testEnginesAgree(minimal, true, "minimal");
+    testRejectedBoardsUnchanged();
+    testCStatusCodes();
+    testEnumerationRejectsClashes();
+
+    if (failures > 0) {
+        cerr << failures << " check(s) failed" << endl;
+        return 1;
+    }
+    cout << "All solver checks passed" << endl;
+    return 0;
+}